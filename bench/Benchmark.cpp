@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+#ifndef SNAKE_VERSION
+#define SNAKE_VERSION "unknown"
+#endif
+
+#ifndef SNAKE_BUILD_TYPE
+#define SNAKE_BUILD_TYPE ""
+#endif
+
+namespace {
+
+// Escape a string for inclusion in JSON output
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+BenchRunner::BenchRunner(const BenchOptions& options)
+    : options(options) {
+}
+
+bool BenchRunner::isEnabled(const std::string& name) const {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+double BenchRunner::timeBatch(const std::function<void(long long)>& fn, long long n) {
+    auto start = std::chrono::steady_clock::now();
+    fn(n);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+BenchResult* BenchRunner::run(const std::string& name, long long param,
+                              const std::function<void(long long)>& fn) {
+    if (!isEnabled(name)) return nullptr;
+
+    // Calibrate: grow the batch until one repetition lasts at least minTimeMs
+    const double minTimeNs = options.minTimeMs * 1e6;
+    long long iterations = 1;
+    double elapsed = timeBatch(fn, iterations);
+    while (elapsed < minTimeNs && iterations < (1LL << 40)) {
+        double scale = (elapsed > 0.0) ? (minTimeNs * 1.2) / elapsed : 10.0;
+        scale = std::min(std::max(scale, 2.0), 10.0);
+        iterations = static_cast<long long>(iterations * scale);
+        elapsed = timeBatch(fn, iterations);
+    }
+
+    // Timed repetitions
+    std::vector<double> samples;
+    for (int i = 0; i < options.repetitions; ++i) {
+        samples.push_back(timeBatch(fn, iterations) / static_cast<double>(iterations));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = name;
+    result.param = param;
+    result.iterations = iterations;
+    result.bestNsPerOp = samples.front();
+    result.medianNsPerOp = samples[samples.size() / 2];
+    results.push_back(result);
+
+    printf("%-36s %10lld %14.1f ns/op %14.1f best\n",
+           name.c_str(), param, result.medianNsPerOp, result.bestNsPerOp);
+    fflush(stdout);
+    return &results.back();
+}
+
+void BenchRunner::addCounter(BenchResult& result, const std::string& key, double value) {
+    result.counters.emplace_back(key, value);
+    printf("%-36s %10s %14.2f %s\n", "", "", value, key.c_str());
+}
+
+bool BenchRunner::writeJson() const {
+    if (options.outPath.empty()) return true;
+
+    std::ofstream file(options.outPath);
+    if (!file.is_open()) {
+        printf("Error: Could not open %s for writing\n", options.outPath.c_str());
+        return false;
+    }
+
+    time_t now = time(nullptr);
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    file << "{\n";
+    file << "  \"suite\": \"snake_bench\",\n";
+    file << "  \"version\": \"" << jsonEscape(SNAKE_VERSION) << "\",\n";
+    file << "  \"build_type\": \"" << jsonEscape(SNAKE_BUILD_TYPE) << "\",\n";
+    file << "  \"timestamp\": \"" << timestamp << "\",\n";
+    file << "  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        file << "    {\"name\": \"" << jsonEscape(r.name) << "\""
+             << ", \"param\": " << r.param
+             << ", \"iterations\": " << r.iterations
+             << ", \"ns_per_op\": " << r.medianNsPerOp
+             << ", \"best_ns_per_op\": " << r.bestNsPerOp;
+
+        if (!r.counters.empty()) {
+            file << ", \"counters\": {";
+            for (size_t c = 0; c < r.counters.size(); ++c) {
+                if (c > 0) file << ", ";
+                file << "\"" << jsonEscape(r.counters[c].first) << "\": " << r.counters[c].second;
+            }
+            file << "}";
+        }
+
+        file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    file << "  ]\n}\n";
+    printf("\nWrote %zu results to %s\n", results.size(), options.outPath.c_str());
+    return true;
+}
@@ -0,0 +1,76 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Result of one benchmark case
+struct BenchResult {
+    std::string name;         // Case name, e.g. "snake.move"
+    long long param;          // Problem size (snake length, entry count, ...)
+    long long iterations;     // Operations per timed repetition
+    double bestNsPerOp;       // Fastest repetition
+    double medianNsPerOp;     // Median repetition (the number to compare)
+    std::vector<std::pair<std::string, double>> counters; // Extra metrics
+};
+
+// Command line settings for a benchmark run
+struct BenchOptions {
+    std::string filter;   // Only run cases whose name contains this
+    std::string outPath;  // Machine-readable JSON results
+    double minTimeMs;     // Minimum duration of one repetition
+    int repetitions;      // Timed repetitions per case
+    bool render;          // Run the renderer and scene cases
+    bool headless;        // Draw offscreen even when a display exists
+
+    BenchOptions()
+        : outPath("bench_results.json")
+        , minTimeMs(200.0)
+        , repetitions(5)
+        , render(true)
+        , headless(false) {}
+};
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options);
+
+    // Check whether a case passes the --filter option
+    bool isEnabled(const std::string& name) const;
+
+    // Time a case. fn(n) must perform exactly n operations. Returns the
+    // case's result (valid until the next run), or nullptr if --filter
+    // skipped it.
+    BenchResult* run(const std::string& name, long long param,
+                     const std::function<void(long long)>& fn);
+
+    // Attach an extra metric to a result
+    void addCounter(BenchResult& result, const std::string& key, double value);
+
+    // Write all results as JSON to options.outPath
+    bool writeJson() const;
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+private:
+    // Time n operations, in nanoseconds
+    static double timeBatch(const std::function<void(long long)>& fn, long long n);
+
+    BenchOptions options;
+    std::vector<BenchResult> results;
+};
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+#endif // BENCHMARK_H
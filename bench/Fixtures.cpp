@@ -0,0 +1,51 @@
+#include "Fixtures.h"
+#include <SDL2/SDL.h>
+#include <cstdio>
+
+std::vector<Position> makeSerpentine(int length) {
+    std::vector<Position> path;
+    path.reserve(length);
+    for (int i = 0; i < length; ++i) {
+        int row = i / Constants::GRID_WIDTH;
+        int col = i % Constants::GRID_WIDTH;
+        if (row % 2 == 1) col = Constants::GRID_WIDTH - 1 - col;
+        path.push_back({col, row});
+    }
+    return std::vector<Position>(path.rbegin(), path.rend());
+}
+
+Direction serpentineDirection(int length) {
+    int headRow = (length - 1) / Constants::GRID_WIDTH;
+    return (headRow % 2 == 0) ? Direction::RIGHT : Direction::LEFT;
+}
+
+std::string makeScoreJson(int entries) {
+    std::string json = "{\n  \"scores\": [\n";
+    for (int i = 0; i < entries; ++i) {
+        char line[96];
+        snprintf(line, sizeof(line),
+                 "    {\"initials\": \"%c%c%c\", \"score\": %d, \"date\": \"2025-12-%02d\"}%s\n",
+                 'A' + i % 26, 'A' + (i / 26) % 26, 'A' + (i / 676) % 26,
+                 (i * 7919) % 100000 + 10, i % 28 + 1,
+                 (i + 1 < entries) ? "," : "");
+        json += line;
+    }
+    json += "  ]\n}";
+    return json;
+}
+
+bool openBenchRenderer(Renderer& renderer, bool headless) {
+    if (!headless) {
+        // Present must not wait for vblank or every case measures the refresh rate
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+
+        if (renderer.init()) {
+            return true;
+        }
+
+        printf("No display available, using the offscreen software renderer\n");
+        renderer.shutdown();
+    }
+
+    return renderer.initHeadless();
+}
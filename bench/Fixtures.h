@@ -0,0 +1,25 @@
+#ifndef FIXTURES_H
+#define FIXTURES_H
+
+#include <string>
+#include <vector>
+#include "Snake.h"
+#include "Renderer.h"
+
+// Build a serpentine body of the given length, head first. Rows are
+// GRID_WIDTH wide; bodies longer than the board continue below it, which
+// the timed code does not care about.
+std::vector<Position> makeSerpentine(int length);
+
+// Direction the head of a serpentine body is travelling in
+Direction serpentineDirection(int length);
+
+// Generate a high score file with the given number of entries
+std::string makeScoreJson(int entries);
+
+// Open a renderer for benchmarking with vsync disabled. Uses a window when
+// one can be created, otherwise (or when headless is set) the offscreen
+// software renderer.
+bool openBenchRenderer(Renderer& renderer, bool headless);
+
+#endif // FIXTURES_H
@@ -0,0 +1,148 @@
+#include "Scenes.h"
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Fixtures.h"
+#include "Food.h"
+#include "HighScoreManager.h"
+
+namespace {
+
+struct Scene {
+    const char* name;
+    long long param; // Snake length or table size
+    std::function<void(Renderer&)> draw;
+};
+
+// Draw the playing field the way Game::renderPlaying() does
+void drawPlaying(Renderer& renderer, const Snake& snake, const Food& food) {
+    renderer.drawBoard(snake, food);
+    renderer.drawScore(snake.getLength() * 10, 99990);
+}
+
+// Advance the snake one cell along a loop just inside the walls, so a
+// moving snake can be replayed for any number of frames
+void stepAroundBoard(Snake& snake) {
+    const Position& head = snake.getHead();
+    const int right = Constants::GRID_WIDTH - 2;
+    const int bottom = Constants::GRID_HEIGHT - 2;
+
+    if (head.y == 1 && head.x < right) {
+        snake.setDirection(Direction::RIGHT);
+    } else if (head.x == right && head.y < bottom) {
+        snake.setDirection(Direction::DOWN);
+    } else if (head.y == bottom && head.x > 1) {
+        snake.setDirection(Direction::LEFT);
+    } else {
+        snake.setDirection(Direction::UP);
+    }
+    snake.move();
+}
+
+// Draw one frame of a moving snake in the given board mode
+void drawMoving(Renderer& renderer, BoardRenderMode mode, Snake& snake, const Food& food) {
+    renderer.setBoardRenderMode(mode);
+    stepAroundBoard(snake);
+    drawPlaying(renderer, snake, food);
+}
+
+// Replay every scene on one backend; case names start with prefix
+void benchScenesOn(BenchRunner& bench, RenderBackendType type, const char* prefix) {
+    Renderer renderer;
+    if (!renderer.initHeadless(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, type)) {
+        printf("Skipping %s benchmarks: could not create offscreen renderer\n", prefix);
+        return;
+    }
+
+    const int boardCells = Constants::GRID_WIDTH * Constants::GRID_HEIGHT;
+
+    Snake shortSnake;
+    Snake longSnake;
+    longSnake.setSegments(makeSerpentine(256), serpentineDirection(256));
+    Snake fullSnake;
+    fullSnake.setSegments(makeSerpentine(boardCells - 1), serpentineDirection(boardCells - 1));
+
+    // Straight along the top row, heading right
+    const int movingLength = 32;
+    std::vector<Position> movingBody;
+    for (int i = 0; i < movingLength; ++i) {
+        movingBody.push_back({movingLength - i, 1});
+    }
+    Snake movingSnake;
+    movingSnake.setSegments(movingBody, Direction::RIGHT);
+
+    Food food;
+    food.spawn(longSnake);
+
+    HighScoreManager scores;
+    scores.parseJson(makeScoreJson(Constants::MAX_HIGH_SCORES));
+
+    const Scene scenes[] = {
+        {"menu", 0, [](Renderer& r) { r.drawMenu(1); }},
+        {"long_snake", longSnake.getLength(),
+         [&](Renderer& r) { drawPlaying(r, longSnake, food); }},
+        {"full_board", fullSnake.getLength(),
+         [&](Renderer& r) { drawPlaying(r, fullSnake, food); }},
+        {"moving_full", movingSnake.getLength(),
+         [&](Renderer& r) { drawMoving(r, BoardRenderMode::FULL, movingSnake, food); }},
+        {"moving_incremental", movingSnake.getLength(),
+         [&](Renderer& r) { drawMoving(r, BoardRenderMode::INCREMENTAL, movingSnake, food); }},
+        {"moving_framebuffer", movingSnake.getLength(),
+         [&](Renderer& r) { drawMoving(r, BoardRenderMode::CELL_FRAMEBUFFER, movingSnake, food); }},
+        {"full_board_framebuffer", fullSnake.getLength(),
+         [&](Renderer& r) {
+             r.setBoardRenderMode(BoardRenderMode::CELL_FRAMEBUFFER);
+             drawPlaying(r, fullSnake, food);
+         }},
+        {"high_scores", static_cast<long long>(scores.getScores().size()),
+         [&](Renderer& r) { r.drawHighScores(scores.getScores()); }},
+        {"pause", shortSnake.getLength(),
+         [&](Renderer& r) {
+             drawPlaying(r, shortSnake, food);
+             r.drawPauseScreen();
+         }},
+    };
+
+    for (const Scene& scene : scenes) {
+        std::string name = std::string(prefix) + scene.name;
+        if (!bench.isEnabled(name)) continue;
+
+        // Scenes that need another board mode switch on their first frame
+        renderer.setBoardRenderMode(BoardRenderMode::FULL);
+
+        BenchResult* result = bench.run(name, scene.param, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                renderer.clear();
+                scene.draw(renderer);
+                renderer.present();
+            }
+        });
+        if (!result) continue;
+
+        // Count the work done by one frame of the scene
+        renderer.resetStats();
+        renderer.clear();
+        scene.draw(renderer);
+        renderer.present();
+
+        const RenderStats& stats = renderer.getStats();
+        bench.addCounter(*result, "fps", 1e9 / result->medianNsPerOp);
+        bench.addCounter(*result, "draw_calls_per_frame", static_cast<double>(stats.drawCalls));
+        bench.addCounter(*result, "text_renders_per_frame", static_cast<double>(stats.textRenders));
+
+        const TextCacheStats& cache = renderer.getTextCache().getStats();
+        bench.addCounter(*result, "text_cache_hits_per_frame", static_cast<double>(cache.hits));
+        bench.addCounter(*result, "text_cache_misses_per_frame", static_cast<double>(cache.misses));
+        bench.addCounter(*result, "text_cache_bytes", static_cast<double>(cache.bytes));
+    }
+
+    renderer.shutdown();
+}
+
+} // namespace
+
+void benchScenes(BenchRunner& bench) {
+    benchScenesOn(bench, RenderBackendType::SOFTWARE, "scene.");
+    benchScenesOn(bench, RenderBackendType::NONE, "scene_null.");
+}
@@ -0,0 +1,13 @@
+#ifndef SCENES_H
+#define SCENES_H
+
+#include "Benchmark.h"
+
+// Replay representative screens (menu, long snake, full board, a moving
+// snake in each board render mode, high score table, pause overlay) and
+// report frames per second and draw calls per frame for each. scene.* runs
+// on the software rasterizer; scene_null.* repeats them on the null
+// backend, which measures everything except drawing pixels.
+void benchScenes(BenchRunner& bench);
+
+#endif // SCENES_H
@@ -0,0 +1,385 @@
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "Fixtures.h"
+#include "Scenes.h"
+#include "Snake.h"
+#include "Food.h"
+#include "ParticleSystem.h"
+#include "HighScoreManager.h"
+#include "Leaderboard.h"
+#include "ScoreStore.h"
+#include "Renderer.h"
+#include "FrameCapture.h"
+#include "Synth.h"
+#include "VoicePool.h"
+
+// snake_bench - microbenchmarks for the core game operations.
+//
+// Usage: snake_bench [--filter=TEXT] [--out=FILE] [--min-time=MS]
+//                    [--repetitions=N] [--no-render] [--headless]
+//
+// Results are printed as a table and written as JSON (bench_results.json by
+// default) so runs from different releases can be diffed. Cases are
+// parameterized by problem size so a jump from linear to quadratic growth
+// shows up as a ratio change between rows.
+//
+// The scene.* cases always run on the offscreen software renderer (and
+// scene_null.* on the null backend) and also report fps and draw calls per
+// frame; run them alone with --filter=scene.
+
+namespace {
+
+const int SNAKE_LENGTHS[] = {4, 64, 512, 1024, 4096, 16384};
+const int SCORE_FILE_ENTRIES[] = {10, 1000, 10000, 100000};
+const int LEADERBOARD_SIZES[] = {1000, 100000, 10000000};
+
+bool parseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--filter=", 9) == 0) {
+            options.filter = arg + 9;
+        } else if (strncmp(arg, "--out=", 6) == 0) {
+            options.outPath = arg + 6;
+        } else if (strncmp(arg, "--min-time=", 11) == 0) {
+            options.minTimeMs = atof(arg + 11);
+        } else if (strncmp(arg, "--repetitions=", 14) == 0) {
+            options.repetitions = atoi(arg + 14);
+            if (options.repetitions < 1) options.repetitions = 1;
+        } else if (strcmp(arg, "--no-render") == 0) {
+            options.render = false;
+        } else if (strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else {
+            printf("Usage: snake_bench [--filter=TEXT] [--out=FILE] [--min-time=MS]\n"
+                   "                   [--repetitions=N] [--no-render] [--headless]\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+void benchSnake(BenchRunner& bench) {
+    for (int length : SNAKE_LENGTHS) {
+        std::vector<Position> body = makeSerpentine(length);
+        Direction dir = serpentineDirection(length);
+        Snake snake;
+
+        bench.run("snake.move", length, [&](long long n) {
+            snake.setSegments(body, dir);
+            for (long long i = 0; i < n; ++i) {
+                snake.move();
+            }
+            doNotOptimize(snake.getHead());
+        });
+
+        snake.setSegments(body, dir);
+        bench.run("snake.checkSelfCollision", length, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                bool hit = snake.checkSelfCollision();
+                doNotOptimize(hit);
+            }
+        });
+
+        // Worst case: a cell the snake does not occupy
+        Position miss = {-1, -1};
+        bench.run("snake.checkCollisionAt", length, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                bool hit = snake.checkCollisionAt(miss);
+                doNotOptimize(hit);
+            }
+        });
+    }
+}
+
+void benchFood(BenchRunner& bench) {
+    for (int length : SNAKE_LENGTHS) {
+        Snake snake;
+        snake.setSegments(makeSerpentine(length), serpentineDirection(length));
+        Food food;
+
+        bench.run("food.spawn", length, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                food.spawn(snake);
+            }
+            doNotOptimize(food.getPosition());
+        });
+    }
+}
+
+void benchHighScores(BenchRunner& bench) {
+    for (int entries : SCORE_FILE_ENTRIES) {
+        std::string json = makeScoreJson(entries);
+
+        BenchResult* result = bench.run("highscores.parseJson", entries, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                HighScoreManager manager;
+                manager.parseJson(json);
+                doNotOptimize(manager.getTopScore());
+            }
+        });
+        if (result) {
+            bench.addCounter(*result, "MB/s", json.size() / (result->medianNsPerOp / 1e3));
+        }
+    }
+
+    HighScoreManager manager;
+    manager.parseJson(makeScoreJson(Constants::MAX_HIGH_SCORES));
+    bench.run("highscores.toJson", static_cast<long long>(manager.getScores().size()), [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            std::string json = manager.toJson();
+            doNotOptimize(json);
+        }
+    });
+}
+
+void benchLeaderboard(BenchRunner& bench) {
+    if (!bench.isEnabled("leaderboard.insert") && !bench.isEnabled("leaderboard.rank") &&
+        !bench.isEnabled("leaderboard.page")) {
+        return;
+    }
+
+    // Random scores, the same every run
+    uint32_t seed = 12345;
+    auto randomScore = [&seed] {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return static_cast<int>(seed % 1000000) + 1;
+    };
+
+    for (int size : LEADERBOARD_SIZES) {
+        Leaderboard leaderboard;
+        std::vector<LeaderboardEntry> entries;
+        entries.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            entries.push_back(Leaderboard::makeEntry(randomScore(), "AAA", "2025-12-01"));
+        }
+        leaderboard.build(std::move(entries));
+
+        // The table grows by the inserts timed; a small fraction of it
+        bench.run("leaderboard.insert", size, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                LeaderboardEntry entry = Leaderboard::makeEntry(randomScore(), "BBB", "2025-12-02");
+                doNotOptimize(leaderboard.insert(entry));
+            }
+        });
+
+        bench.run("leaderboard.rank", size, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                doNotOptimize(leaderboard.countAbove(randomScore()));
+            }
+        });
+
+        // A screenful of the table from anywhere in it
+        std::vector<LeaderboardEntry> page;
+        bench.run("leaderboard.page", size, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                leaderboard.page(seed % leaderboard.size(), Constants::MAX_HIGH_SCORES, page);
+                randomScore();
+                doNotOptimize(page);
+            }
+        });
+    }
+}
+
+void benchScoreStore(BenchRunner& bench) {
+    if (!bench.isEnabled("scorestore.open")) return;
+
+    const std::string path = "bench_scores.dat";
+    for (int size : LEADERBOARD_SIZES) {
+        // A compacted file with a few scores added since, as the game leaves it
+        {
+            ScoreStore store(path);
+            store.open();
+            std::vector<LeaderboardEntry> entries;
+            entries.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                entries.push_back(Leaderboard::makeEntry(i * 7919 % 1000000, "AAA", "2025-12-01"));
+            }
+            store.replaceAll(std::move(entries));
+            for (int i = 0; i < 100; ++i) {
+                store.add(Leaderboard::makeEntry(i * 104729 % 1000000, "BBB", "2025-12-02"));
+            }
+            store.flush();
+        }
+
+        // Open the file and rank one score, as the game over screen does
+        bench.run("scorestore.open", size, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                ScoreStore store(path);
+                store.open();
+                doNotOptimize(store.countAbove(500000));
+            }
+        });
+    }
+    remove(path.c_str());
+}
+
+void benchParticles(BenchRunner& bench) {
+    // A full pool stepped by dt 0: every step does the full work on every
+    // particle, but nothing expires or decays into denormals over millions
+    // of steps
+    ParticleSystem particles;
+    SDL_Color color = {255, 255, 255, 255};
+    particles.emit(20.0f, 13.0f, particles.getCapacity(), color, 10.0f, 1.0f);
+
+    bench.run("particles.update", particles.getCount(), [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            particles.update(0.0f);
+        }
+        doNotOptimize(particles.getX()[0]);
+    });
+}
+
+void benchCapture(BenchRunner& bench) {
+    // The encoder thread's per-frame conversion for Y4M recording
+    const int width = Constants::WINDOW_WIDTH;
+    const int height = Constants::WINDOW_HEIGHT;
+    std::vector<Uint32> frame(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = 0xFF000000u | static_cast<Uint32>(i * 2654435761u >> 8);
+    }
+
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    std::vector<Uint8> yuv(frame.size() + 2 * chroma);
+    const long long pixels = static_cast<long long>(frame.size());
+    BenchResult* result = bench.run("capture.convertToI420", pixels, [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            FrameCapture::convertToI420(frame.data(), width, height, yuv.data(),
+                                        yuv.data() + frame.size(),
+                                        yuv.data() + frame.size() + chroma);
+        }
+        doNotOptimize(yuv[0]);
+    });
+    if (result) bench.addCounter(*result, "fps", 1e9 / result->medianNsPerOp);
+}
+
+void benchVoicePool(BenchRunner& bench) {
+    // Sounds started into a pool that is always full, so every start
+    // steals: the worst case when events fire faster than sounds end
+    struct Voice {
+        int position;
+    };
+    VoicePool<Voice, Constants::SOUND_VOICES> pool;
+    const VoiceRules eat = {Constants::EAT_SOUND_PRIORITY, Constants::SOUND_VOICES};
+    for (int i = 0; i < pool.capacity(); ++i) pool.start(0, eat, 1.0f)->position = 0;
+
+    bench.run("voicepool.start", pool.capacity(), [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            Voice* voice = pool.start(static_cast<int>(i & 1), eat, 1.0f);
+            voice->position = static_cast<int>(i);
+        }
+        doNotOptimize(pool);
+    });
+}
+
+void benchSynth(BenchRunner& bench) {
+    if (!bench.isEnabled("synth.mix")) return;
+
+    // One default-size mixer buffer of the built-in tune, with an eat
+    // sound starting every other buffer
+    const VoiceRules rules = {Constants::EAT_SOUND_PRIORITY, Constants::EAT_SOUND_MAX_VOICES};
+    Synth synth;
+    synth.setSampleRate(Constants::AUDIO_FREQUENCY);
+    synth.playMusic(Constants::MUSIC_VOLUME);
+
+    const int frames = Constants::AUDIO_CHUNK_SIZE;
+    std::vector<Sint16> buffer(static_cast<size_t>(frames) * Constants::AUDIO_CHANNELS);
+    BenchResult* result = bench.run("synth.mix", frames, [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            if (i % 2 == 0) synth.playSound(SoundId::EAT, Constants::SFX_VOLUME, rules);
+            std::fill(buffer.begin(), buffer.end(), 0);
+            synth.mix(buffer.data(), frames, Constants::AUDIO_CHANNELS);
+        }
+        doNotOptimize(buffer[0]);
+    });
+    if (!result) return;
+
+    // Share of one core the audio thread spends synthesizing
+    const double bufferNs = 1e9 * frames / Constants::AUDIO_FREQUENCY;
+    bench.addCounter(*result, "core_percent", 100.0 * result->medianNsPerOp / bufferNs);
+}
+
+void benchRenderer(BenchRunner& bench, bool headless) {
+    Renderer renderer;
+    if (!openBenchRenderer(renderer, headless)) {
+        printf("Skipping renderer benchmarks: could not create a renderer\n");
+        return;
+    }
+
+    // Each operation is one full frame: clear, draw, present
+    auto frame = [&](const char* name, long long param, const std::function<void()>& draw) {
+        bench.run(name, param, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                renderer.clear();
+                draw();
+                renderer.present();
+            }
+        });
+    };
+
+    frame("renderer.clear", 0, [] {});
+    frame("renderer.drawGrid", 0, [&] { renderer.drawGrid(); });
+
+    const int boardCells = Constants::GRID_WIDTH * Constants::GRID_HEIGHT;
+    for (int length : {4, 64, 512, boardCells}) {
+        Snake snake;
+        snake.setSegments(makeSerpentine(length), serpentineDirection(length));
+        frame("renderer.drawSnake", length, [&] { renderer.drawSnake(snake); });
+    }
+
+    Snake snake;
+    Food food;
+    food.spawn(snake);
+    frame("renderer.drawFood", 0, [&] { renderer.drawFood(food); });
+    ParticleSystem particles;
+    particles.emit(20.0f, 13.0f, Constants::DEATH_PARTICLES, SDL_Color{57, 255, 20, 255},
+                   Constants::DEATH_PARTICLE_SPEED, 1e9f);
+    particles.update(0.1f); // Spread out
+    frame("renderer.drawParticles", particles.getCount(), [&] { renderer.drawParticles(particles); });
+    frame("renderer.drawScore", 0, [&] { renderer.drawScore(1230, 4560); });
+    frame("renderer.drawMenu", 0, [&] { renderer.drawMenu(1); });
+    frame("renderer.drawPauseScreen", 0, [&] { renderer.drawPauseScreen(); });
+
+    HighScoreManager manager;
+    manager.parseJson(makeScoreJson(Constants::MAX_HIGH_SCORES));
+    frame("renderer.drawHighScores", static_cast<long long>(manager.getScores().size()),
+          [&] { renderer.drawHighScores(manager.getScores()); });
+
+    renderer.shutdown();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        return 1;
+    }
+
+    printf("%-36s %10s %20s %19s\n", "case", "param", "median", "best");
+
+    BenchRunner bench(options);
+    benchSnake(bench);
+    benchFood(bench);
+    benchHighScores(bench);
+    benchLeaderboard(bench);
+    benchScoreStore(bench);
+    benchParticles(bench);
+    benchCapture(bench);
+    benchVoicePool(bench);
+    benchSynth(bench);
+
+    if (options.render) {
+        benchRenderer(bench, options.headless);
+        benchScenes(bench);
+        SDL_Quit();
+    }
+
+    return bench.writeJson() ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include "AssetPackFormat.h"
+
+namespace {
+
+// The process-wide pack behind openAsset
+AssetPack mountedPack;
+
+} // namespace
+
+AssetPack::AssetPack() {
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const char* path) {
+    close();
+    if (!file.open(path)) return false;
+
+    if (!parseIndex()) {
+        printf("Warning: Asset pack %s is damaged, ignoring it\n", path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool AssetPack::parseIndex() {
+    using namespace AssetPackFormat;
+
+    const Uint8* data = file.getData();
+    const size_t size = file.getSize();
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        readU32(data + 8) != VERSION) {
+        return false;
+    }
+
+    const size_t count = readU32(data + 12);
+    if (count > (size - HEADER_SIZE) / ENTRY_SIZE) return false;
+
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Uint8* record = data + HEADER_SIZE + i * ENTRY_SIZE;
+        const char* name = reinterpret_cast<const char*>(record);
+        uint64_t offset = readU64(record + NAME_SIZE);
+        uint64_t length = readU64(record + NAME_SIZE + 8);
+
+        // Names must be terminated and blobs inside the file
+        if (memchr(name, '\0', NAME_SIZE) == nullptr) return false;
+        if (offset > size || length > size - offset) return false;
+
+        entries.push_back({name, data + offset, static_cast<size_t>(length)});
+    }
+
+    // The packer writes them sorted; don't rely on it for the search
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return strcmp(a.name, b.name) < 0;
+    });
+    return true;
+}
+
+void AssetPack::close() {
+    entries.clear();
+    file.close();
+}
+
+const Uint8* AssetPack::find(const char* name, size_t* fileSize) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), name,
+                               [](const Entry& entry, const char* key) {
+                                   return strcmp(entry.name, key) < 0;
+                               });
+    if (it == entries.end() || strcmp(it->name, name) != 0) return nullptr;
+
+    *fileSize = it->size;
+    return it->data;
+}
+
+bool mountAssetPack(const char* path) {
+    if (!mountedPack.open(path)) return false;
+
+    printf("Using asset pack %s (%d files)\n", path, mountedPack.getCount());
+    return true;
+}
+
+void unmountAssetPack() {
+    mountedPack.close();
+}
+
+SDL_RWops* openAsset(const std::string& path) {
+    size_t fileSize = 0;
+    const Uint8* packed = mountedPack.find(path.c_str(), &fileSize);
+    if (packed && fileSize <= static_cast<size_t>(INT_MAX)) {
+        return SDL_RWFromConstMem(packed, static_cast<int>(fileSize));
+    }
+
+    // Not packed (or no pack): a loose file, e.g. while developing
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
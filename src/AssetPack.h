@@ -0,0 +1,57 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// A read-only view of an asset pack (see AssetPackFormat.h). The file is
+// memory-mapped, so opening it reads nothing but the index, and packed
+// files are handed out as pointers into the mapping without copying.
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Map a pack and check its index. False if it is missing or damaged.
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    // Contents of a packed file, or nullptr if the pack doesn't have it.
+    // Valid until close().
+    const Uint8* find(const char* name, size_t* size) const;
+
+    int getCount() const { return static_cast<int>(entries.size()); }
+
+private:
+    struct Entry {
+        const char* name; // Points into the mapping
+        const Uint8* data;
+        size_t size;
+    };
+
+    // Read the index of the mapped file
+    bool parseIndex();
+
+    MappedFile file;
+    std::vector<Entry> entries;
+};
+
+// The game's assets come from one pack mounted for the whole process.
+// Mount it before any loader thread starts, and unmount it after every
+// font, sound and music opened from it has been closed.
+bool mountAssetPack(const char* path);
+void unmountAssetPack();
+
+// Open an asset by path: from the mounted pack when it has the file
+// (reading straight from the mapping), from disk otherwise. Returns
+// nullptr (with SDL_GetError set) if neither has it. Safe on any thread.
+SDL_RWops* openAsset(const std::string& path);
+
+#endif // ASSETPACK_H
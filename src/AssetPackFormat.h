@@ -0,0 +1,35 @@
+#ifndef ASSETPACKFORMAT_H
+#define ASSETPACKFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ByteOrder.h"
+
+// Layout of an asset pack, shared by the game and the packer tool (so it
+// must not need SDL). All numbers are little-endian.
+//
+//   Header   MAGIC, VERSION (u32), entry count (u32)
+//   Index    one ENTRY_SIZE record per file, sorted by name:
+//            name (NAME_SIZE bytes, NUL padded), offset (u64), size (u64)
+//   Blobs    file contents, each starting on an ALIGNMENT boundary
+//
+// Names are the paths the game opens, relative to its working directory
+// with '/' separators (e.g. "assets/fonts/pixel.ttf").
+namespace AssetPackFormat {
+
+constexpr char MAGIC[8] = {'S', 'N', 'A', 'K', 'P', 'A', 'C', 'K'};
+constexpr uint32_t VERSION = 1;
+
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t NAME_SIZE = 48;                // Including the terminating NUL
+constexpr size_t ENTRY_SIZE = NAME_SIZE + 16;
+constexpr size_t ALIGNMENT = 64;                // Cache line; keeps decoders aligned
+
+using ByteOrder::readU32;
+using ByteOrder::readU64;
+using ByteOrder::writeU32;
+using ByteOrder::writeU64;
+
+} // namespace AssetPackFormat
+
+#endif // ASSETPACKFORMAT_H
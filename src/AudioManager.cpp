@@ -1,12 +1,69 @@
 #include "AudioManager.h"
+#include <algorithm>
 #include <cstdio>
+#include "AssetPack.h"
+
+namespace {
+
+// How each sound competes for voices
+VoiceRules soundRules(SoundId sound) {
+    switch (sound) {
+        case SoundId::GAME_OVER:
+            return {Constants::GAMEOVER_SOUND_PRIORITY, Constants::GAMEOVER_SOUND_MAX_VOICES};
+        case SoundId::EAT:
+            break;
+    }
+    return {Constants::EAT_SOUND_PRIORITY, Constants::EAT_SOUND_MAX_VOICES};
+}
+
+// Add a sound into the mix at a volume (0-128), clipping like SDL_mixer
+void mixSamples(Sint16* out, const Sint16* in, Uint32 count, int volume) {
+    for (Uint32 i = 0; i < count; ++i) {
+        int sample = out[i] + in[i] * volume / 128;
+        out[i] = static_cast<Sint16>(std::min(std::max(sample, -32768), 32767));
+    }
+}
+
+// Decode a sound effect; a missing one is synthesized instead
+Mix_Chunk* loadSound(const char* path, const char* what) {
+    SDL_RWops* rw = openAsset(path);
+    Mix_Chunk* sound = rw ? Mix_LoadWAV_RW(rw, 1) : nullptr;
+    if (!sound) {
+        printf("Note: No %s sound (%s), using the built-in one\n", what, Mix_GetError());
+    }
+    return sound;
+}
+
+// Music is streamed from the pack while it plays, never copied
+Mix_Music* loadMusic(const char* path) {
+    SDL_RWops* rw = openAsset(path);
+    Mix_Music* music = rw ? Mix_LoadMUS_RW(rw, 1) : nullptr;
+    if (!music) {
+        printf("Note: No background music (%s), using the built-in tune\n", Mix_GetError());
+    }
+    return music;
+}
+
+} // namespace
 
 AudioManager::AudioManager()
     : eatSound(nullptr)
     , gameOverSound(nullptr)
     , bgMusic(nullptr)
+    , bufferFrames(Constants::AUDIO_CHUNK_SIZE)
+    , deviceFrequency(Constants::AUDIO_FREQUENCY)
+    , bufferTicks(0)
+    , musicWake(nullptr)
+    , musicStopping(false)
+    , lastMixTicks(0)
+    , mixedBuffers(0)
+    , underrunCount(0)
+    , latencyCount(0)
+    , latencyTotalTicks(0)
+    , latencyWorstTicks(0)
     , initialized(false)
     , muted(false)
+    , musicPlaying(false)
     , musicVolume(Constants::MUSIC_VOLUME)
     , sfxVolume(Constants::SFX_VOLUME) {
 }
@@ -16,46 +73,122 @@ AudioManager::~AudioManager() {
 }
 
 bool AudioManager::init() {
-    // Initialize SDL_mixer
-    if (Mix_OpenAudio(Constants::AUDIO_FREQUENCY,
-                      MIX_DEFAULT_FORMAT,
-                      Constants::AUDIO_CHANNELS,
-                      Constants::AUDIO_CHUNK_SIZE) < 0) {
-        printf("Warning: Could not initialize audio: %s\n", Mix_GetError());
-        printf("Game will run without sound.\n");
+    if (!openDevice()) {
         return false;
     }
 
     // Load sound effects
-    eatSound = Mix_LoadWAV(Constants::EAT_SOUND_PATH);
-    if (!eatSound) {
-        printf("Warning: Could not load eat sound: %s\n", Mix_GetError());
+    eatSound = loadSound(Constants::EAT_SOUND_PATH, "eat");
+    gameOverSound = loadSound(Constants::GAMEOVER_SOUND_PATH, "game over");
+
+    // Load background music
+    bgMusic = loadMusic(Constants::BGM_PATH);
+    return true;
+}
+
+bool AudioManager::initAsync(StartupTimeline& timeline) {
+    if (!openDevice()) {
+        return false;
+    }
+
+    // Decoding needs the device format, so it starts once the device is open
+    soundLoad = std::async(std::launch::async, [&timeline] {
+        return timeline.time("sounds", [] {
+            SoundSet sounds;
+            sounds.eat = loadSound(Constants::EAT_SOUND_PATH, "eat");
+            sounds.gameOver = loadSound(Constants::GAMEOVER_SOUND_PATH, "game over");
+            return sounds;
+        });
+    });
+    musicLoad = std::async(std::launch::async, [&timeline] {
+        return timeline.time("music", [] { return loadMusic(Constants::BGM_PATH); });
+    });
+    return true;
+}
+
+bool AudioManager::finishLoading() {
+    if (isLoadFinished(soundLoad)) {
+        SoundSet sounds = soundLoad.get();
+        eatSound = sounds.eat;
+        gameOverSound = sounds.gameOver;
     }
+    if (isLoadFinished(musicLoad)) {
+        bgMusic = musicLoad.get();
+    }
+    return !soundLoad.valid() && !musicLoad.valid();
+}
 
-    gameOverSound = Mix_LoadWAV(Constants::GAMEOVER_SOUND_PATH);
-    if (!gameOverSound) {
-        printf("Warning: Could not load game over sound: %s\n", Mix_GetError());
+void AudioManager::waitForLoads() {
+    if (soundLoad.valid()) soundLoad.wait();
+    if (musicLoad.valid()) musicLoad.wait();
+    finishLoading();
+}
+
+bool AudioManager::openDevice() {
+    // Initialize SDL_mixer. Take the device's own sample rate: converting
+    // to ours would add a resampling buffer on top of the one we asked for.
+    if (Mix_OpenAudioDevice(Constants::AUDIO_FREQUENCY,
+                            MIX_DEFAULT_FORMAT,
+                            Constants::AUDIO_CHANNELS,
+                            bufferFrames,
+                            nullptr,
+                            SDL_AUDIO_ALLOW_FREQUENCY_CHANGE) < 0) {
+        printf("Warning: Could not initialize audio: %s\n", Mix_GetError());
+        printf("Game will run without sound.\n");
+        return false;
     }
 
-    // Load background music
-    bgMusic = Mix_LoadMUS(Constants::BGM_PATH);
-    if (!bgMusic) {
-        printf("Warning: Could not load background music: %s\n", Mix_GetError());
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    if (Mix_QuerySpec(&frequency, &format, &channels) && frequency > 0) {
+        deviceFrequency = frequency;
     }
+    bufferTicks = SDL_GetPerformanceFrequency() * static_cast<Uint64>(bufferFrames) /
+                  static_cast<Uint64>(deviceFrequency);
 
-    // Set initial volumes
-    Mix_VolumeMusic(musicVolume);
+    // Mix sound effects and time every buffer the mixer produces
+    synth.setSampleRate(deviceFrequency);
+    lastMixTicks = 0;
+    Mix_SetPostMix(postMix, this);
 
     initialized = true;
+    startMusicThread();
+
+    // Set initial volumes
+    postMusic(MusicCommand::VOLUME, musicVolume);
     return true;
 }
 
 void AudioManager::shutdown() {
     if (!initialized) return;
 
-    // Stop all audio
-    Mix_HaltMusic();
-    Mix_HaltChannel(-1);
+    // Loaded sounds must be freed before the device closes
+    waitForLoads();
+
+    // Stop all audio (the music thread halts the music as it stops). Once
+    // the callback is gone nothing else reads the voices or the ring, so
+    // drop what they still hold.
+    stopMusicThread();
+    Mix_SetPostMix(nullptr, nullptr);
+    voices.clear();
+    Command stale;
+    while (commands.pop(stale)) {}
+    synth.stopMusic();
+    musicPlaying = false;
+
+    AudioStats audioStats = getStats();
+    if (audioStats.buffers > 0) {
+        printf("Audio: %d-frame buffer at %d Hz (%.1f ms), latency %.1f ms average, "
+               "%.1f ms worst, %llu underruns in %llu buffers, "
+               "%llu sounds cut short, %llu dropped\n",
+               audioStats.bufferFrames, audioStats.frequency, audioStats.bufferMs,
+               audioStats.averageLatencyMs, audioStats.worstLatencyMs,
+               static_cast<unsigned long long>(audioStats.underruns),
+               static_cast<unsigned long long>(audioStats.buffers),
+               static_cast<unsigned long long>(audioStats.stolenVoices),
+               static_cast<unsigned long long>(audioStats.droppedSounds));
+    }
 
     // Free sound effects
     if (eatSound) {
@@ -79,59 +212,246 @@ void AudioManager::shutdown() {
     initialized = false;
 }
 
-void AudioManager::playEatSound() {
-    if (!initialized || muted || !eatSound) return;
+void AudioManager::post(Command::Type type, int volume, const Mix_Chunk* sound,
+                        SoundId soundId) {
+    Command command = {type, sound, soundId, volume, SDL_GetPerformanceCounter()};
 
-    Mix_VolumeChunk(eatSound, sfxVolume);
-    Mix_PlayChannel(-1, eatSound, 0);
+    // The ring only fills if the audio thread has stalled; losing a
+    // command then beats waiting for it
+    commands.push(command);
 }
 
-void AudioManager::playGameOverSound() {
-    if (!initialized || muted || !gameOverSound) return;
+void AudioManager::postMusic(MusicCommand::Type type, int volume, Mix_Music* music) {
+    if (!musicWake) return;
 
-    Mix_VolumeChunk(gameOverSound, sfxVolume);
-    Mix_PlayChannel(-1, gameOverSound, 0);
+    // Like post, a full ring loses the command rather than waiting
+    MusicCommand command = {type, music, volume};
+    if (musicCommands.push(command)) SDL_SemPost(musicWake);
 }
 
-void AudioManager::playBackgroundMusic() {
-    if (!initialized || !bgMusic) return;
+void AudioManager::startMusicThread() {
+    musicWake = SDL_CreateSemaphore(0);
+    if (!musicWake) {
+        printf("Warning: Could not start the music thread: %s\n", SDL_GetError());
+        return;
+    }
 
-    if (!muted) {
-        Mix_VolumeMusic(musicVolume);
-    } else {
-        Mix_VolumeMusic(0);
+    musicStopping = false;
+    musicThread = std::thread(&AudioManager::musicLoop, this);
+}
+
+void AudioManager::stopMusicThread() {
+    if (!musicWake) return;
+
+    musicStopping.store(true, std::memory_order_release);
+    SDL_SemPost(musicWake);
+    musicThread.join();
+
+    MusicCommand stale;
+    while (musicCommands.pop(stale)) {}
+    SDL_DestroySemaphore(musicWake);
+    musicWake = nullptr;
+}
+
+void AudioManager::musicLoop() {
+    // Each call here may wait for the mixer to finish a buffer; only this
+    // thread notices
+    while (true) {
+        SDL_SemWait(musicWake);
+
+        MusicCommand command;
+        while (musicCommands.pop(command)) {
+            switch (command.type) {
+                case MusicCommand::PLAY:
+                    Mix_VolumeMusic(command.volume);
+                    // Play music with infinite loop (-1)
+                    if (Mix_PlayMusic(command.music, -1) < 0) {
+                        printf("Warning: Could not play music: %s\n", Mix_GetError());
+                    }
+                    break;
+                case MusicCommand::HALT:
+                    Mix_HaltMusic();
+                    break;
+                case MusicCommand::PAUSE:
+                    Mix_PauseMusic();
+                    break;
+                case MusicCommand::RESUME:
+                    Mix_ResumeMusic();
+                    break;
+                case MusicCommand::VOLUME:
+                    Mix_VolumeMusic(command.volume);
+                    break;
+            }
+        }
+
+        if (musicStopping.load(std::memory_order_acquire)) break;
     }
 
-    // Play music with infinite loop (-1)
-    if (Mix_PlayMusic(bgMusic, -1) < 0) {
-        printf("Warning: Could not play music: %s\n", Mix_GetError());
+    Mix_HaltMusic();
+}
+
+void AudioManager::postMix(void* udata, Uint8* stream, int length) {
+    AudioManager* self = static_cast<AudioManager*>(udata);
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // The device plays one buffer while the next is mixed; a mix that
+    // starts well over a buffer after the last one left it with nothing
+    Uint64 last = self->lastMixTicks.exchange(now, std::memory_order_relaxed);
+    if (last != 0 && now - last > self->bufferTicks + self->bufferTicks / 2) {
+        self->underrunCount.fetch_add(1, std::memory_order_relaxed);
     }
+    self->mixedBuffers.fetch_add(1, std::memory_order_relaxed);
+
+    // openDevice doesn't let SDL change the mixer's format (signed 16-bit)
+    Sint16* samples = reinterpret_cast<Sint16*>(stream);
+    const int count = length / static_cast<int>(sizeof(Sint16));
+    self->runCommands(now);
+    self->mixVoices(samples, count);
+    self->synth.mix(samples, count / Constants::AUDIO_CHANNELS, Constants::AUDIO_CHANNELS);
+}
+
+void AudioManager::runCommands(Uint64 now) {
+    // Nothing here may call SDL_mixer: the callback runs inside it
+    Command command;
+    while (commands.pop(command)) {
+        switch (command.type) {
+            case Command::PLAY_SOUND:
+                startSound(command, now);
+                break;
+            case Command::PLAY_SYNTH_MUSIC:
+                synth.playMusic(command.volume);
+                break;
+            case Command::HALT_MUSIC:
+                synth.stopMusic();
+                break;
+            case Command::PAUSE_MUSIC:
+                synth.pauseMusic();
+                break;
+            case Command::RESUME_MUSIC:
+                synth.resumeMusic();
+                break;
+            case Command::MUSIC_VOLUME:
+                synth.setMusicVolume(command.volume);
+                break;
+        }
+    }
+}
+
+void AudioManager::startSound(const Command& command, Uint64 now) {
+    const VoiceRules rules = soundRules(command.soundId);
+    if (!command.sound) {
+        synth.playSound(command.soundId, command.volume, rules);
+        recordLatency(command, now);
+        return;
+    }
+
+    Voice* voice = voices.start(static_cast<int>(command.soundId), rules,
+                                static_cast<float>(command.volume));
+    if (!voice) return;
+
+    voice->samples = reinterpret_cast<const Sint16*>(command.sound->abuf);
+    voice->length = command.sound->alen / sizeof(Sint16);
+    voice->position = 0;
+    voice->volume = command.volume;
+    recordLatency(command, now);
+}
+
+void AudioManager::recordLatency(const Command& command, Uint64 now) {
+    // The sound starts in the buffer being mixed, which plays after the current one
+    if (now >= command.requestTicks) {
+        Uint64 latency = now - command.requestTicks + bufferTicks;
+        latencyCount.fetch_add(1, std::memory_order_relaxed);
+        latencyTotalTicks.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > latencyWorstTicks.load(std::memory_order_relaxed)) {
+            latencyWorstTicks.store(latency, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AudioManager::mixVoices(Sint16* stream, int samples) {
+    voices.update([&](Voice& voice) {
+        Uint32 count = std::min(static_cast<Uint32>(samples), voice.length - voice.position);
+        mixSamples(stream, voice.samples + voice.position, count, voice.volume);
+        voice.position += count;
+        return voice.position < voice.length;
+    });
+}
+
+AudioStats AudioManager::getStats() const {
+    const double ticksToMs = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    AudioStats audioStats;
+    audioStats.frequency = deviceFrequency;
+    audioStats.bufferFrames = bufferFrames;
+    audioStats.bufferMs = 1000.0 * bufferFrames / deviceFrequency;
+    audioStats.buffers = mixedBuffers.load(std::memory_order_relaxed);
+    audioStats.underruns = underrunCount.load(std::memory_order_relaxed);
+    audioStats.latencyCount = latencyCount.load(std::memory_order_relaxed);
+    if (audioStats.latencyCount > 0) {
+        audioStats.averageLatencyMs = latencyTotalTicks.load(std::memory_order_relaxed) *
+                                      ticksToMs / audioStats.latencyCount;
+        audioStats.worstLatencyMs = latencyWorstTicks.load(std::memory_order_relaxed) * ticksToMs;
+    }
+    audioStats.stolenVoices = voices.getStolen() + synth.getStolenVoices();
+    audioStats.droppedSounds = voices.getDropped() + synth.getDroppedSounds();
+    return audioStats;
+}
+
+void AudioManager::playSound(SoundId soundId, const Mix_Chunk* sound) {
+    if (!initialized || muted) return;
+    post(Command::PLAY_SOUND, sfxVolume, sound, soundId);
+}
+
+void AudioManager::playEatSound() {
+    playSound(SoundId::EAT, eatSound);
+}
+
+void AudioManager::playGameOverSound() {
+    playSound(SoundId::GAME_OVER, gameOverSound);
+}
+
+void AudioManager::playBackgroundMusic() {
+    if (!initialized) return;
+
+    const int volume = muted ? 0 : musicVolume;
+    if (bgMusic) {
+        postMusic(MusicCommand::PLAY, volume, bgMusic);
+    } else {
+        post(Command::PLAY_SYNTH_MUSIC, volume);
+    }
+    musicPlaying = true;
 }
 
 void AudioManager::stopBackgroundMusic() {
     if (!initialized) return;
-    Mix_HaltMusic();
+
+    if (bgMusic) postMusic(MusicCommand::HALT);
+    post(Command::HALT_MUSIC);
+    musicPlaying = false;
 }
 
 void AudioManager::pauseBackgroundMusic() {
     if (!initialized) return;
-    Mix_PauseMusic();
+    if (bgMusic) postMusic(MusicCommand::PAUSE);
+    post(Command::PAUSE_MUSIC);
 }
 
 void AudioManager::resumeBackgroundMusic() {
     if (!initialized) return;
-    Mix_ResumeMusic();
+    if (bgMusic) postMusic(MusicCommand::RESUME);
+    post(Command::RESUME_MUSIC);
 }
 
 bool AudioManager::isMusicPlaying() const {
-    if (!initialized) return false;
-    return Mix_PlayingMusic() != 0;
+    // Asking SDL_mixer would take the device lock
+    return initialized && musicPlaying;
 }
 
 void AudioManager::setMusicVolume(int volume) {
     musicVolume = (volume < 0) ? 0 : (volume > 128) ? 128 : volume;
     if (initialized && !muted) {
-        Mix_VolumeMusic(musicVolume);
+        postMusic(MusicCommand::VOLUME, musicVolume);
+        post(Command::MUSIC_VOLUME, musicVolume);
     }
 }
 
@@ -143,10 +463,7 @@ void AudioManager::toggleMute() {
     muted = !muted;
 
     if (initialized) {
-        if (muted) {
-            Mix_VolumeMusic(0);
-        } else {
-            Mix_VolumeMusic(musicVolume);
-        }
+        postMusic(MusicCommand::VOLUME, muted ? 0 : musicVolume);
+        post(Command::MUSIC_VOLUME, muted ? 0 : musicVolume);
     }
 }
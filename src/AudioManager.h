@@ -2,21 +2,71 @@
 #define AUDIOMANAGER_H
 
 #include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <future>
 #include <string>
+#include <thread>
 #include "Constants.h"
+#include "SpscRing.h"
+#include "StartupTimeline.h"
+#include "Synth.h"
+#include "VoicePool.h"
 
+// Audio timing, measured on the audio thread (see AudioManager::getStats)
+struct AudioStats {
+    int frequency;       // Device sample rate
+    int bufferFrames;    // Device buffer size
+    double bufferMs;     // Time one buffer plays for
+    Uint64 buffers;      // Buffers mixed
+    Uint64 underruns;    // Buffers mixed too late to play without a gap
+    Uint64 latencyCount; // Sounds timed
+    double averageLatencyMs;
+    double worstLatencyMs;
+    Uint64 stolenVoices;  // Sounds cut short to make room for another
+    Uint64 droppedSounds; // Sounds that found every voice more important
+
+    AudioStats()
+        : frequency(0), bufferFrames(0), bufferMs(0.0), buffers(0), underruns(0)
+        , latencyCount(0), averageLatencyMs(0.0), worstLatencyMs(0.0)
+        , stolenVoices(0), droppedSounds(0) {}
+};
+
+// Playback calls never touch SDL_mixer (whose calls take the audio device
+// lock, stalling the game loop behind the mixer). They post a command to a
+// lock-free ring instead:
+//   - sound effects and the synthesizer's music go to the audio thread,
+//     where the post-mix callback applies them before each buffer and
+//     mixes the sound effects itself
+//   - SDL_mixer's music controls go to a music thread, the only caller of
+//     Mix_*Music: they may not be called from SDL_mixer's own callbacks
+//
+// A sound or music file that is missing is replaced by the built-in
+// synthesizer, which also runs on the audio thread.
 class AudioManager {
 public:
     AudioManager();
     ~AudioManager();
 
+    // Device buffer in sample frames (call before init). Smaller buffers
+    // play sounds sooner but leave the audio thread less slack: watch the
+    // underrun count when lowering it.
+    void setBufferFrames(int frames) { bufferFrames = frames; }
+
     // Initialize audio system
     bool init();
 
+    // Open the audio device and decode the sounds and music on loader
+    // threads; they play once finishLoading has taken them
+    bool initAsync(StartupTimeline& timeline);
+
+    // Take finished sounds and music; never waits. True once nothing is
+    // left loading.
+    bool finishLoading();
+
     // Shutdown audio system
     void shutdown();
 
-    // Play sound effects
+    // Play sound effects (game thread only, like every playback call)
     void playEatSound();
     void playGameOverSound();
 
@@ -35,7 +85,96 @@ public:
     void toggleMute();
     bool isMuted() const { return muted; }
 
+    // Buffer size, output latency and underruns so far. Latency runs from
+    // a play call until the sound starts mixing, plus one buffer for the mixed
+    // audio to reach the speakers. Underruns are buffers whose mix started
+    // more than half a buffer late, which the device heard as a gap.
+    AudioStats getStats() const;
+
 private:
+    // Sound effects decoded together on a loader thread
+    struct SoundSet {
+        Mix_Chunk* eat;
+        Mix_Chunk* gameOver;
+    };
+
+    // Open the mixer at the game's format
+    bool openDevice();
+
+    // Sent by the game thread to the audio thread
+    struct Command {
+        enum Type {
+            PLAY_SOUND,
+            PLAY_SYNTH_MUSIC, // The music commands drive the synthesizer
+            HALT_MUSIC,
+            PAUSE_MUSIC,
+            RESUME_MUSIC,
+            MUSIC_VOLUME
+        };
+
+        Type type;
+        const Mix_Chunk* sound; // PLAY_SOUND; nullptr to synthesize it
+        SoundId soundId;        // PLAY_SOUND
+        int volume;             // PLAY_SOUND, PLAY_SYNTH_MUSIC, MUSIC_VOLUME
+        Uint64 requestTicks;
+    };
+
+    // Sent by the game thread to the music thread
+    struct MusicCommand {
+        enum Type {
+            PLAY,
+            HALT,
+            PAUSE,
+            RESUME,
+            VOLUME
+        };
+
+        Type type;
+        Mix_Music* music; // PLAY
+        int volume;       // PLAY, VOLUME
+    };
+
+    // A sound effect being mixed; audio thread only
+    struct Voice {
+        const Sint16* samples;
+        Uint32 length;         // In samples, all channels
+        Uint32 position;
+        int volume;
+    };
+
+    // Queue a command for the audio thread; never blocks
+    void post(Command::Type type, int volume = 0, const Mix_Chunk* sound = nullptr,
+              SoundId soundId = SoundId::EAT);
+
+    // Queue a command for the music thread; never blocks
+    void postMusic(MusicCommand::Type type, int volume = 0, Mix_Music* music = nullptr);
+
+    // Start and stop the music thread
+    void startMusicThread();
+    void stopMusicThread();
+
+    // Music thread: apply queued commands whenever woken
+    void musicLoop();
+
+    // Play a loaded sound, or the synthesizer's version when there isn't one
+    void playSound(SoundId soundId, const Mix_Chunk* sound);
+
+    // Runs on the audio thread after the music is mixed into each buffer
+    static void postMix(void* udata, Uint8* stream, int length);
+
+    // Audio thread: apply queued commands, then mix the sound effects
+    void runCommands(Uint64 now);
+    void startSound(const Command& command, Uint64 now);
+    void recordLatency(const Command& command, Uint64 now);
+    void mixVoices(Sint16* stream, int samples);
+
+    // Wait for loads still running and take their results
+    void waitForLoads();
+
+    // Loads started by initAsync
+    std::future<SoundSet> soundLoad;
+    std::future<Mix_Music*> musicLoad;
+
     // Sound effects
     Mix_Chunk* eatSound;
     Mix_Chunk* gameOverSound;
@@ -43,9 +182,34 @@ private:
     // Background music
     Mix_Music* bgMusic;
 
+    // Device settings
+    int bufferFrames;
+    int deviceFrequency;
+    Uint64 bufferTicks; // One buffer in performance counter ticks
+
+    // Game thread -> audio thread
+    SpscRing<Command, Constants::AUDIO_COMMAND_QUEUE> commands;
+    VoicePool<Voice, Constants::SOUND_VOICES> voices;
+    Synth synth; // Audio thread only, once the device is open
+
+    // Game thread -> music thread
+    SpscRing<MusicCommand, Constants::MUSIC_COMMAND_QUEUE> musicCommands;
+    SDL_sem* musicWake; // Posted after each command, and to stop
+    std::atomic<bool> musicStopping;
+    std::thread musicThread;
+
+    // Written by the audio thread, read by getStats
+    std::atomic<Uint64> lastMixTicks;
+    std::atomic<Uint64> mixedBuffers;
+    std::atomic<Uint64> underrunCount;
+    std::atomic<Uint64> latencyCount;
+    std::atomic<Uint64> latencyTotalTicks;
+    std::atomic<Uint64> latencyWorstTicks;
+
     // State
     bool initialized;
     bool muted;
+    bool musicPlaying; // As last posted
     int musicVolume;
     int sfxVolume;
 };
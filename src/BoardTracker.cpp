@@ -0,0 +1,118 @@
+#include "BoardTracker.h"
+#include <algorithm>
+
+BoardTracker::BoardTracker(int width, int height)
+    : width(0)
+    , height(0)
+    , headStamp(0)
+    , chunksWide(0)
+    , chunksHigh(0)
+    , valid(false)
+    , lastGeneration(0)
+    , lastStep(0)
+    , lastLength(0)
+    , lastHead{0, 0}
+    , lastTail{0, 0} {
+    changes.reserve(8);
+    resize(width, height);
+}
+
+void BoardTracker::resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    cells.assign(static_cast<size_t>(width) * height, CellContent::EMPTY);
+    stamps.assign(cells.size(), 0);
+
+    chunksWide = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksHigh = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkCounts.assign(static_cast<size_t>(chunksWide) * chunksHigh, 0);
+
+    valid = false;
+}
+
+void BoardTracker::invalidate() {
+    valid = false;
+}
+
+bool BoardTracker::inBounds(const Position& pos) const {
+    return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+}
+
+CellContent BoardTracker::getCell(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return CellContent::EMPTY;
+    return cells[static_cast<size_t>(y) * width + x];
+}
+
+void BoardTracker::storeCell(const Position& pos, CellContent content) {
+    CellContent& cell = cells[static_cast<size_t>(pos.y) * width + pos.x];
+    uint16_t& count = chunkCounts[static_cast<size_t>(pos.y / CHUNK_SIZE) * chunksWide +
+                                  pos.x / CHUNK_SIZE];
+    if (cell == CellContent::EMPTY && content != CellContent::EMPTY) ++count;
+    if (cell != CellContent::EMPTY && content == CellContent::EMPTY) --count;
+    cell = content;
+}
+
+void BoardTracker::setCell(const Position& pos, CellContent content) {
+    if (!inBounds(pos)) return; // The head leaves the board on a wall hit
+
+    storeCell(pos, content);
+    changes.push_back({pos, content});
+}
+
+void BoardTracker::rebuild(const Snake& snake) {
+    std::fill(cells.begin(), cells.end(), CellContent::EMPTY);
+    std::fill(chunkCounts.begin(), chunkCounts.end(), 0);
+
+    // Tail first, so where segments overlap the one nearer the head wins
+    const auto& segments = snake.getSegments();
+    for (size_t i = segments.size(); i-- > 0;) {
+        if (inBounds(segments[i])) {
+            storeCell(segments[i], (i == 0) ? CellContent::HEAD : CellContent::BODY);
+            stamps[static_cast<size_t>(segments[i].y) * width + segments[i].x] =
+                headStamp - static_cast<uint32_t>(i);
+        }
+    }
+}
+
+bool BoardTracker::sync(const Snake& snake) {
+    changes.clear();
+
+    bool fullRebuild = !valid ||
+                       snake.getGeneration() != lastGeneration ||
+                       snake.getStepCount() < lastStep ||
+                       snake.getStepCount() > lastStep + 1 ||
+                       snake.getLength() < lastLength ||
+                       snake.getLength() > lastLength + 1 ||
+                       snake.getLength() == 0;
+
+    if (fullRebuild) {
+        rebuild(snake);
+    } else if (snake.getStepCount() == lastStep + 1) {
+        // One move: vacate the tail unless the snake grew, then move the head.
+        // The tail goes first because the head may enter the vacated cell.
+        if (snake.getLength() == lastLength) {
+            setCell(lastTail, CellContent::EMPTY);
+        }
+        if (snake.getLength() > 1) {
+            setCell(lastHead, CellContent::BODY);
+        }
+        setCell(snake.getHead(), CellContent::HEAD);
+
+        ++headStamp;
+        const Position& head = snake.getHead();
+        if (inBounds(head)) {
+            stamps[static_cast<size_t>(head.y) * width + head.x] = headStamp;
+        }
+    }
+
+    valid = snake.getLength() > 0;
+    lastGeneration = snake.getGeneration();
+    lastStep = snake.getStepCount();
+    lastLength = snake.getLength();
+    if (valid) {
+        lastHead = snake.getHead();
+        lastTail = snake.getTail();
+    }
+
+    return fullRebuild;
+}
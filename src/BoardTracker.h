@@ -0,0 +1,104 @@
+#ifndef BOARDTRACKER_H
+#define BOARDTRACKER_H
+
+#include <cstdint>
+#include <vector>
+#include "Snake.h"
+
+// What a board cell shows
+enum class CellContent : uint8_t {
+    EMPTY,
+    BODY,
+    HEAD
+};
+
+// One cell that must be repainted
+struct CellChange {
+    Position pos;
+    CellContent content;
+};
+
+// Mirrors which board cells the snake covers and reports only the cells
+// that changed since the last sync. Between two ticks that is the old head,
+// the new head and (unless the snake grew) the vacated tail, so keeping a
+// persistent picture of the board up to date costs O(1) per tick instead
+// of O(length) per frame.
+//
+// The board is also split into CHUNK_SIZE x CHUNK_SIZE chunks that count
+// their occupied cells, a coarse index for drawing only the part of a big
+// board that is on screen: empty chunks are skipped without looking at
+// their cells, so the cost follows the visible area rather than the snake
+// length or the board size.
+class BoardTracker {
+public:
+    static constexpr int CHUNK_SIZE = 16;
+
+    BoardTracker(int width, int height);
+    ~BoardTracker() = default;
+
+    // Change the board size; the next sync is a full rebuild
+    void resize(int width, int height);
+
+    // Forget the tracked state; the next sync is a full rebuild
+    void invalidate();
+
+    // Bring the tracked board up to date with the snake. Returns true when
+    // everything must be repainted (first sync, snake reset, missed steps);
+    // otherwise getChanges() lists the cells to repaint.
+    bool sync(const Snake& snake);
+
+    // Cells changed by the last incremental sync, in paint order
+    const std::vector<CellChange>& getChanges() const { return changes; }
+
+    // Current content of a cell (EMPTY outside the board)
+    CellContent getCell(int x, int y) const;
+
+    // Position in the body of an occupied cell (0 = head, length - 1 =
+    // tail); meaningless for empty cells
+    int getSegmentIndex(int x, int y) const {
+        return static_cast<int>(headStamp - stamps[static_cast<size_t>(y) * width + x]);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Occupied cells in a chunk (chunk coordinates, not cells)
+    int getChunkCount(int chunkX, int chunkY) const {
+        return chunkCounts[static_cast<size_t>(chunkY) * chunksWide + chunkX];
+    }
+    int getChunksWide() const { return chunksWide; }
+    int getChunksHigh() const { return chunksHigh; }
+
+private:
+    bool inBounds(const Position& pos) const;
+    void setCell(const Position& pos, CellContent content);
+    void rebuild(const Snake& snake);
+
+    // Write a cell and keep its chunk count in step
+    void storeCell(const Position& pos, CellContent content);
+
+    int width;
+    int height;
+    std::vector<CellContent> cells;
+    std::vector<CellChange> changes;
+
+    // Each occupied cell remembers the value of headStamp when the head
+    // entered it, so its index in the body is headStamp minus its stamp
+    // (wrapping arithmetic keeps that right forever)
+    std::vector<uint32_t> stamps;
+    uint32_t headStamp;
+
+    int chunksWide;
+    int chunksHigh;
+    std::vector<uint16_t> chunkCounts;
+
+    // Snake state at the last sync
+    bool valid;
+    uint32_t lastGeneration;
+    uint64_t lastStep;
+    int lastLength;
+    Position lastHead;
+    Position lastTail;
+};
+
+#endif // BOARDTRACKER_H
@@ -0,0 +1,30 @@
+#ifndef BYTEORDER_H
+#define BYTEORDER_H
+
+#include <cstdint>
+
+// Little-endian integers in byte buffers, for the file formats (so it must
+// not need SDL)
+namespace ByteOrder {
+
+inline uint32_t readU32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline uint64_t readU64(const unsigned char* p) {
+    return static_cast<uint64_t>(readU32(p)) | static_cast<uint64_t>(readU32(p + 4)) << 32;
+}
+
+inline void writeU32(unsigned char* p, uint32_t value) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+inline void writeU64(unsigned char* p, uint64_t value) {
+    writeU32(p, static_cast<uint32_t>(value));
+    writeU32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+} // namespace ByteOrder
+
+#endif // BYTEORDER_H
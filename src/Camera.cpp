@@ -0,0 +1,105 @@
+#include "Camera.h"
+#include <algorithm>
+
+namespace {
+
+// Step a scroll position toward its target; at least one pixel per frame
+// so it always arrives
+int approach(int current, int target) {
+    int delta = target - current;
+    if (delta == 0) return current;
+
+    int step = delta / Constants::CAMERA_SMOOTHING;
+    if (step == 0) step = (delta > 0) ? 1 : -1;
+    return current + step;
+}
+
+} // namespace
+
+Camera::Camera()
+    : viewport{0, Constants::GRID_OFFSET_Y, Constants::WINDOW_WIDTH,
+               Constants::WINDOW_HEIGHT - Constants::GRID_OFFSET_Y}
+    , boardWidth(Constants::GRID_WIDTH)
+    , boardHeight(Constants::GRID_HEIGHT)
+    , zoomLevel(Constants::DEFAULT_ZOOM_LEVEL)
+    , cellSize(Constants::ZOOM_CELL_SIZES[Constants::DEFAULT_ZOOM_LEVEL])
+    , scrollX(0)
+    , scrollY(0) {
+}
+
+void Camera::setViewport(const SDL_Rect& rect) {
+    viewport = rect;
+    clampScroll();
+}
+
+void Camera::setBoardSize(int width, int height) {
+    boardWidth = width;
+    boardHeight = height;
+    clampScroll();
+}
+
+void Camera::zoom(int steps) {
+    int level = std::min(std::max(zoomLevel + steps, 0), Constants::ZOOM_LEVEL_COUNT - 1);
+    if (level == zoomLevel) return;
+
+    // Board pixel under the middle of the view, scaled to the new size
+    int newSize = Constants::ZOOM_CELL_SIZES[level];
+    int centerX = (scrollX + viewport.w / 2) * newSize / cellSize;
+    int centerY = (scrollY + viewport.h / 2) * newSize / cellSize;
+
+    zoomLevel = level;
+    cellSize = newSize;
+    scrollX = centerX - viewport.w / 2;
+    scrollY = centerY - viewport.h / 2;
+    clampScroll();
+}
+
+void Camera::follow(const Position& cell, bool snap) {
+    int targetX = cell.x * cellSize + cellSize / 2 - viewport.w / 2;
+    int targetY = cell.y * cellSize + cellSize / 2 - viewport.h / 2;
+
+    if (snap) {
+        scrollX = targetX;
+        scrollY = targetY;
+    } else {
+        scrollX = approach(scrollX, targetX);
+        scrollY = approach(scrollY, targetY);
+    }
+    clampScroll();
+}
+
+void Camera::clampScroll() {
+    int boardPixelsW = boardWidth * cellSize;
+    int boardPixelsH = boardHeight * cellSize;
+
+    if (boardPixelsW <= viewport.w) {
+        scrollX = -(viewport.w - boardPixelsW) / 2;
+    } else {
+        scrollX = std::min(std::max(scrollX, 0), boardPixelsW - viewport.w);
+    }
+
+    if (boardPixelsH <= viewport.h) {
+        scrollY = -(viewport.h - boardPixelsH) / 2;
+    } else {
+        scrollY = std::min(std::max(scrollY, 0), boardPixelsH - viewport.h);
+    }
+}
+
+SDL_Rect Camera::getVisibleCells() const {
+    // Floor division (scroll is negative when the board is centered)
+    auto cellAt = [this](int pixel) {
+        return (pixel >= 0) ? pixel / cellSize : -((cellSize - 1 - pixel) / cellSize);
+    };
+
+    int x0 = std::max(cellAt(scrollX), 0);
+    int y0 = std::max(cellAt(scrollY), 0);
+    int x1 = std::min(cellAt(scrollX + viewport.w - 1) + 1, boardWidth);
+    int y1 = std::min(cellAt(scrollY + viewport.h - 1) + 1, boardHeight);
+
+    return {x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0)};
+}
+
+bool Camera::isIdentity() const {
+    return cellSize == Constants::CELL_SIZE && scrollX == 0 && scrollY == 0 &&
+           boardWidth * cellSize == viewport.w && boardHeight * cellSize == viewport.h;
+}
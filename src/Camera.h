@@ -0,0 +1,58 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SDL2/SDL.h>
+#include "Constants.h"
+#include "Snake.h"
+
+// Which part of the board is on screen. The viewport is the playfield
+// area of the window (below the HUD); the camera scrolls over the board
+// in whole pixels and zooms in steps of whole-pixel cell sizes, so cells
+// always land on the pixel grid. A board smaller than the viewport is
+// centered in it instead of scrolled.
+class Camera {
+public:
+    Camera();
+
+    void setViewport(const SDL_Rect& rect);
+    const SDL_Rect& getViewport() const { return viewport; }
+
+    // Board size in cells
+    void setBoardSize(int width, int height);
+
+    // Zoom in (positive) or out (negative) by whole levels, keeping the
+    // middle of the view in place
+    void zoom(int steps);
+    int getZoomLevel() const { return zoomLevel; }
+    int getCellSize() const { return cellSize; }
+
+    // Scroll toward centering a cell; snap jumps there at once
+    void follow(const Position& cell, bool snap = false);
+
+    // Screen position of a cell's top-left corner
+    int cellToScreenX(int cellX) const { return viewport.x + cellX * cellSize - scrollX; }
+    int cellToScreenY(int cellY) const { return viewport.y + cellY * cellSize - scrollY; }
+
+    // Cells at least partly inside the viewport, clipped to the board
+    SDL_Rect getVisibleCells() const;
+
+    // True when the whole default-sized board fills the viewport exactly,
+    // the layout the pre-composited layers are drawn for
+    bool isIdentity() const;
+
+private:
+    // Keep the view on the board, or center a board that fits
+    void clampScroll();
+
+    SDL_Rect viewport;
+    int boardWidth;
+    int boardHeight;
+    int zoomLevel;
+    int cellSize;
+
+    // Board pixel at the viewport's top-left corner (negative when centered)
+    int scrollX;
+    int scrollY;
+};
+
+#endif // CAMERA_H
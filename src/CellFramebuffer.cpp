@@ -0,0 +1,148 @@
+#include "CellFramebuffer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "Constants.h"
+
+namespace {
+
+constexpr Uint32 packColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return (static_cast<Uint32>(a) << 24) | (static_cast<Uint32>(r) << 16) |
+           (static_cast<Uint32>(g) << 8) | static_cast<Uint32>(b);
+}
+
+// Empty cells are transparent so the grid drawn underneath shows through
+constexpr Uint32 EMPTY_COLOR = 0;
+constexpr Uint32 BODY_COLOR = packColor(Constants::Colors::BODY_R, Constants::Colors::BODY_G,
+                                        Constants::Colors::BODY_B, Constants::Colors::BODY_A);
+constexpr Uint32 HEAD_COLOR = packColor(Constants::Colors::HEAD_R, Constants::Colors::HEAD_G,
+                                        Constants::Colors::HEAD_B, Constants::Colors::HEAD_A);
+constexpr Uint32 FOOD_COLOR = packColor(Constants::Colors::FOOD_R, Constants::Colors::FOOD_G,
+                                        Constants::Colors::FOOD_B, Constants::Colors::FOOD_A);
+
+} // namespace
+
+CellFramebuffer::CellFramebuffer(int width, int height)
+    : width(width)
+    , height(height)
+    , pixels(static_cast<size_t>(width) * height, EMPTY_COLOR)
+    , backend(nullptr)
+    , texture(nullptr)
+    , dirtyMinY(0)
+    , dirtyMaxY(height - 1)
+    , hasFood(false)
+    , foodPos{0, 0} {
+}
+
+CellFramebuffer::~CellFramebuffer() {
+    destroy();
+}
+
+void CellFramebuffer::resize(int newWidth, int newHeight) {
+    destroy();
+    width = newWidth;
+    height = newHeight;
+    pixels.assign(static_cast<size_t>(width) * height, EMPTY_COLOR);
+    dirtyMinY = 0;
+    dirtyMaxY = height - 1;
+    hasFood = false;
+}
+
+bool CellFramebuffer::create(RenderBackend& backend) {
+    destroy();
+    this->backend = &backend;
+
+    texture = backend.createTexture(width, height, TextureAccess::STREAMING);
+    if (!texture) {
+        printf("Warning: Could not create cell framebuffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Each texel must stay a sharp square when stretched over its cell
+    backend.setTextureScaleMode(texture, SDL_ScaleModeNearest);
+    backend.setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    // The new texture has undefined contents
+    dirtyMinY = 0;
+    dirtyMaxY = height - 1;
+    return true;
+}
+
+void CellFramebuffer::destroy() {
+    if (texture) {
+        backend->destroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+Uint32 CellFramebuffer::colorFor(CellContent content) {
+    switch (content) {
+        case CellContent::HEAD: return HEAD_COLOR;
+        case CellContent::BODY: return BODY_COLOR;
+        default:                return EMPTY_COLOR;
+    }
+}
+
+void CellFramebuffer::setCell(int x, int y, Uint32 color) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+
+    pixels[static_cast<size_t>(y) * width + x] = color;
+    dirtyMinY = std::min(dirtyMinY, y);
+    dirtyMaxY = std::max(dirtyMaxY, y);
+}
+
+void CellFramebuffer::sync(const BoardTracker& tracker, bool fullRebuild, const Position& food) {
+    if (fullRebuild) {
+        for (int y = 0; y < height; ++y) {
+            Uint32* row = &pixels[static_cast<size_t>(y) * width];
+            for (int x = 0; x < width; ++x) {
+                row[x] = colorFor(tracker.getCell(x, y));
+            }
+        }
+        dirtyMinY = 0;
+        dirtyMaxY = height - 1;
+        hasFood = false;
+    } else {
+        for (const CellChange& change : tracker.getChanges()) {
+            setCell(change.pos.x, change.pos.y, colorFor(change.content));
+        }
+    }
+
+    // Give the old food cell back to the board when the food moves
+    if (hasFood && !(foodPos == food)) {
+        setCell(foodPos.x, foodPos.y, colorFor(tracker.getCell(foodPos.x, foodPos.y)));
+    }
+
+    if (food.x >= 0 && food.x < width && food.y >= 0 && food.y < height &&
+        pixels[static_cast<size_t>(food.y) * width + food.x] != FOOD_COLOR) {
+        setCell(food.x, food.y, FOOD_COLOR);
+    }
+    hasFood = true;
+    foodPos = food;
+}
+
+bool CellFramebuffer::upload() {
+    if (!texture || dirtyMinY > dirtyMaxY) return true;
+
+    SDL_Rect rows = {0, dirtyMinY, width, dirtyMaxY - dirtyMinY + 1};
+    const Uint32* first = &pixels[static_cast<size_t>(dirtyMinY) * width];
+    bool ok = backend->updateTexture(texture, &rows, first, width * static_cast<int>(sizeof(Uint32)));
+
+    dirtyMinY = height;
+    dirtyMaxY = -1;
+    return ok;
+}
+
+SDL_Surface* CellFramebuffer::createSnapshot() const {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                          SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) return nullptr;
+
+    SDL_LockSurface(surface);
+    for (int y = 0; y < height; ++y) {
+        memcpy(static_cast<Uint8*>(surface->pixels) + y * surface->pitch,
+               &pixels[static_cast<size_t>(y) * width], width * sizeof(Uint32));
+    }
+    SDL_UnlockSurface(surface);
+    return surface;
+}
@@ -0,0 +1,67 @@
+#ifndef CELLFRAMEBUFFER_H
+#define CELLFRAMEBUFFER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "BoardTracker.h"
+#include "RenderBackend.h"
+
+// The board as a tiny image with one texel per cell. Cells are written
+// into a CPU pixel buffer as the snake moves, the changed rows are uploaded
+// to a streaming texture, and the texture is stretched over the playfield
+// with nearest-neighbour scaling. Drawing the board is then one copy no
+// matter how long the snake is or how big the arena is.
+//
+// The pixel buffer doubles as a board thumbnail (see createSnapshot).
+class CellFramebuffer {
+public:
+    CellFramebuffer(int width, int height);
+    ~CellFramebuffer();
+
+    // Create the streaming texture
+    bool create(RenderBackend& backend);
+    void destroy();
+
+    // Change the board size; destroys the texture (create it again)
+    void resize(int width, int height);
+    bool isReady() const { return texture != nullptr; }
+
+    // Write the board into the pixel buffer: every cell after a full
+    // rebuild of the tracker, otherwise only its changes. The food texel
+    // is drawn over the snake cells.
+    void sync(const BoardTracker& tracker, bool fullRebuild, const Position& food);
+
+    // Upload the rows changed since the last upload. Returns false if the
+    // texture could not be updated.
+    bool upload();
+
+    RenderTexture* getTexture() const { return texture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Pixels in ARGB8888, row by row, one per cell
+    const std::vector<Uint32>& getPixels() const { return pixels; }
+
+    // Copy the board into a new surface, e.g. for a thumbnail. The caller
+    // frees it with SDL_FreeSurface. Returns nullptr on failure.
+    SDL_Surface* createSnapshot() const;
+
+private:
+    void setCell(int x, int y, Uint32 color);
+    static Uint32 colorFor(CellContent content);
+
+    int width;
+    int height;
+    std::vector<Uint32> pixels;
+    RenderBackend* backend; // Owner of texture
+    RenderTexture* texture;
+
+    // Rows written since the last upload (dirtyMinY > dirtyMaxY when clean)
+    int dirtyMinY;
+    int dirtyMaxY;
+
+    bool hasFood;
+    Position foodPos;
+};
+
+#endif // CELLFRAMEBUFFER_H
@@ -1,6 +1,7 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Constants {
@@ -19,11 +20,38 @@ constexpr int GRID_OFFSET_Y = 60; // Top area for score display
 // Game settings
 constexpr int TARGET_FPS = 60;
 constexpr int FRAME_DELAY = 1000 / TARGET_FPS;
+constexpr int CURSOR_BLINK_MS = 500;     // Initials cursor on/off time
 constexpr int INITIAL_SNAKE_LENGTH = 3;
 constexpr int INITIAL_GAME_SPEED = 8; // Snake moves every N frames
 constexpr int MIN_GAME_SPEED = 3;     // Fastest speed
 constexpr int SPEED_INCREASE_INTERVAL = 5; // Speed up every N food eaten
 
+// Renderer settings
+constexpr size_t TEXT_CACHE_MAX_BYTES = 4 * 1024 * 1024; // Cached text textures (at 1x)
+constexpr int MAX_PIXEL_SCALE = 4; // Resolution of text and layers on big or high-DPI windows
+
+// Camera settings (boards bigger than the window scroll with the head)
+constexpr int ZOOM_CELL_SIZES[] = {10, 15, 20, 30, 40}; // Cell size in pixels per zoom level
+constexpr int ZOOM_LEVEL_COUNT = sizeof(ZOOM_CELL_SIZES) / sizeof(ZOOM_CELL_SIZES[0]);
+constexpr int DEFAULT_ZOOM_LEVEL = 2;  // CELL_SIZE
+constexpr int CAMERA_SMOOTHING = 4;    // Close 1/N of the distance to the target per frame
+constexpr int MAX_BOARD_SIZE = 1024;   // Cells per side (--board)
+
+// Particle settings (sizes in cells, speeds in cells per second)
+constexpr int MAX_PARTICLES = 2048;
+constexpr float PARTICLE_DRAG = 3.0f;      // Fraction of speed lost per second
+constexpr float PARTICLE_MIN_SIZE = 0.15f;
+constexpr float PARTICLE_MAX_SIZE = 0.35f;
+constexpr int EAT_PARTICLES = 24;
+constexpr float EAT_PARTICLE_SPEED = 8.0f;
+constexpr float EAT_PARTICLE_LIFE = 0.4f;  // Seconds
+constexpr int DEATH_PARTICLES = 240;
+constexpr float DEATH_PARTICLE_SPEED = 14.0f;
+constexpr float DEATH_PARTICLE_LIFE = 1.2f;
+
+// Frame capture settings
+constexpr int CAPTURE_BUFFER_COUNT = 8; // Frames that can wait for the encoder
+
 // Controller settings
 constexpr int ANALOG_DEAD_ZONE = 8000;
 
@@ -61,12 +89,16 @@ namespace Colors {
 }
 
 // File paths
+constexpr const char* ASSET_PACK_PATH = "assets.pack"; // Built with the game; see AssetPack.h
 constexpr const char* FONT_PATH = "assets/fonts/pixel.ttf";
 constexpr const char* EAT_SOUND_PATH = "assets/sounds/eat.wav";
 constexpr const char* GAMEOVER_SOUND_PATH = "assets/sounds/gameover.wav";
 constexpr const char* BGM_PATH = "assets/sounds/bgm.ogg";
-constexpr const char* HIGHSCORE_PATH = "highscores.json";
+constexpr const char* SCORE_FILE_PATH = "highscores.dat"; // Every score; see ScoreFileFormat.h
+constexpr const char* HIGHSCORE_PATH = "highscores.json"; // Older versions' file, imported once
+constexpr const char* HIGHSCORE_JOURNAL_PATH = "highscores.journal"; // Left by older versions
 constexpr const char* CONTROLLER_DB_PATH = "gamecontrollerdb.txt";
+constexpr const char* SKIN_DIR = "assets/images/skins/"; // One folder per skin
 
 // High score settings
 constexpr int MAX_HIGH_SCORES = 10;
@@ -75,14 +107,28 @@ constexpr int INITIALS_LENGTH = 3;
 // Audio settings
 constexpr int AUDIO_FREQUENCY = 44100;
 constexpr int AUDIO_CHANNELS = 2;
-constexpr int AUDIO_CHUNK_SIZE = 2048;
+constexpr int AUDIO_CHUNK_SIZE = 2048;         // Default buffer, in sample frames
+constexpr int LOW_LATENCY_AUDIO_BUFFER = 256;  // --low-latency
+constexpr int MIN_AUDIO_BUFFER = 64;
+constexpr int MAX_AUDIO_BUFFER = 8192;
 constexpr int MUSIC_VOLUME = 64;  // 0-128
 constexpr int SFX_VOLUME = 100;   // 0-128
+constexpr int SOUND_VOICES = 8;   // Sound effects mixed at once
+
+// When the voices run out a sound takes one from a sound of the same or
+// lower priority; each sound is also capped at a number of copies
+constexpr int EAT_SOUND_PRIORITY = 1;
+constexpr int EAT_SOUND_MAX_VOICES = 3;
+constexpr int GAMEOVER_SOUND_PRIORITY = 2;
+constexpr int GAMEOVER_SOUND_MAX_VOICES = 1;
+constexpr size_t AUDIO_COMMAND_QUEUE = 64; // Game -> audio thread commands
+constexpr size_t MUSIC_COMMAND_QUEUE = 16; // Game -> music thread commands
 
 } // namespace Constants
 
 // Game states
 enum class GameState {
+    LOADING,       // Fonts, sounds and scores loading at startup
     MENU,
     PLAYER_SELECT,
     ENTER_INITIALS,
@@ -94,6 +140,13 @@ enum class GameState {
     FINAL_RESULTS  // For 2-player mode final comparison
 };
 
+// How the playfield is drawn while playing
+enum class BoardRenderMode {
+    FULL,            // Redraw every cell each frame
+    INCREMENTAL,     // Repaint only changed cells into a persistent layer
+    CELL_FRAMEBUFFER // One texel per cell, stretched over the playfield
+};
+
 // Direction enum
 enum class Direction {
     UP,
@@ -123,4 +176,10 @@ enum class MenuOption {
     QUIT
 };
 
+// Sound effects
+enum class SoundId {
+    EAT,
+    GAME_OVER
+};
+
 #endif // CONSTANTS_H
@@ -8,8 +8,8 @@ Food::Food() : position{0, 0}, pulseTimer(0) {
 }
 
 void Food::spawn(const Snake& snake) {
-    std::uniform_int_distribution<int> distX(0, Constants::GRID_WIDTH - 1);
-    std::uniform_int_distribution<int> distY(0, Constants::GRID_HEIGHT - 1);
+    std::uniform_int_distribution<int> distX(0, snake.getArenaWidth() - 1);
+    std::uniform_int_distribution<int> distY(0, snake.getArenaHeight() - 1);
 
     // Keep generating positions until we find one not on the snake
     int attempts = 0;
@@ -0,0 +1,315 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cctype>
+#include "Renderer.h"
+
+#ifdef HAVE_SDL2_IMAGE
+#include <SDL2/SDL_image.h>
+#endif
+
+namespace {
+
+// Lower-case extension including the dot, or ""
+std::string extensionOf(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return "";
+
+    std::string ext = path.substr(dot);
+    for (char& c : ext) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return ext;
+}
+
+// "dir/frame.png", 12 -> "dir/frame_000012.png"
+std::string numberedPath(const std::string& path, Uint64 index) {
+    std::string ext = extensionOf(path);
+    char number[32];
+    snprintf(number, sizeof(number), "_%06llu", static_cast<unsigned long long>(index));
+    return path.substr(0, path.size() - ext.size()) + number + ext;
+}
+
+inline Uint8 clampByte(int value) {
+    return static_cast<Uint8>(std::min(std::max(value, 0), 255));
+}
+
+} // namespace
+
+FrameCapture::FrameCapture()
+    : format(CaptureFormat::Y4M)
+    , width(0)
+    , height(0)
+    , fps(Constants::TARGET_FPS)
+    , file(nullptr)
+    , active(false)
+    , heldBuffer(-1)
+    , framesReady(nullptr)
+    , imageIndex(0)
+    , stopping(false)
+    , captured(0)
+    , dropped(0)
+    , written(0)
+    , errors(0) {
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::formatForPath(const std::string& path, CaptureFormat* format) {
+    std::string ext = extensionOf(path);
+    if (ext == ".y4m") {
+        *format = CaptureFormat::Y4M;
+    } else if (ext == ".raw") {
+        *format = CaptureFormat::RAW;
+    } else if (ext == ".png") {
+        *format = CaptureFormat::PNG;
+    } else if (ext == ".bmp") {
+        *format = CaptureFormat::BMP;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool FrameCapture::start(const std::string& outputPath, int frameWidth, int frameHeight,
+                         int framesPerSecond) {
+    stop();
+
+    if (!formatForPath(outputPath, &format)) {
+        printf("Error: Unknown capture format for %s (use .y4m, .raw, .png or .bmp)\n",
+               outputPath.c_str());
+        return false;
+    }
+
+#ifndef HAVE_SDL2_IMAGE
+    if (format == CaptureFormat::PNG) {
+        printf("Warning: Built without SDL2_image, capturing BMP files instead of PNG\n");
+        format = CaptureFormat::BMP;
+    }
+#endif
+
+    if (frameWidth <= 0 || frameHeight <= 0) return false;
+
+    path = outputPath;
+    width = frameWidth;
+    height = frameHeight;
+    fps = framesPerSecond;
+    imageIndex = 0;
+
+    framesReady = SDL_CreateSemaphore(0);
+    if (!framesReady) {
+        printf("Error: Could not start capture: %s\n", SDL_GetError());
+        return false;
+    }
+
+    if (format == CaptureFormat::Y4M || format == CaptureFormat::RAW) {
+        file = fopen(path.c_str(), "wb");
+        if (!file) {
+            printf("Error: Could not open %s for capture\n", path.c_str());
+            SDL_DestroySemaphore(framesReady);
+            framesReady = nullptr;
+            return false;
+        }
+    }
+
+    // Allocate every buffer up front; capturing never allocates
+    size_t pixels = static_cast<size_t>(width) * height;
+    buffers.assign(Constants::CAPTURE_BUFFER_COUNT, std::vector<Uint32>(pixels));
+    for (int i = 0; i < Constants::CAPTURE_BUFFER_COUNT; ++i) {
+        freeBuffers.push(i);
+    }
+    heldBuffer = -1;
+
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    yuv.resize(pixels + 2 * chroma);
+
+    captured = 0;
+    dropped = 0;
+    written = 0;
+    errors = 0;
+    stopping = false;
+    encoder = std::thread(&FrameCapture::encoderLoop, this);
+    active = true;
+
+    printf("Capturing %dx%d frames to %s\n", width, height, path.c_str());
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!active) return;
+
+    stopping.store(true, std::memory_order_release);
+    SDL_SemPost(framesReady);
+    if (encoder.joinable()) {
+        encoder.join();
+    }
+    SDL_DestroySemaphore(framesReady);
+    framesReady = nullptr;
+
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+
+    // Reset the rings for a later start
+    int index;
+    while (freeBuffers.pop(index)) {}
+    while (filledBuffers.pop(index)) {}
+    buffers.clear();
+    active = false;
+
+    CaptureStats stats = getStats();
+    printf("Capture finished: %llu frames written, %llu dropped, %llu errors\n",
+           static_cast<unsigned long long>(stats.written),
+           static_cast<unsigned long long>(stats.dropped),
+           static_cast<unsigned long long>(stats.errors));
+}
+
+CaptureStats FrameCapture::getStats() const {
+    CaptureStats stats;
+    stats.captured = captured.load();
+    stats.dropped = dropped.load();
+    stats.written = written.load();
+    stats.errors = errors.load();
+    return stats;
+}
+
+void FrameCapture::captureFrame(Renderer& renderer) {
+    if (!active) return;
+
+    int index = heldBuffer;
+    if (index < 0 && !freeBuffers.pop(index)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!renderer.readPixels(buffers[index].data(), width * static_cast<int>(sizeof(Uint32)))) {
+        heldBuffer = index; // Keep it for the next frame
+        errors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Cannot fail: the ring has room for every buffer
+    heldBuffer = -1;
+    filledBuffers.push(index);
+    SDL_SemPost(framesReady);
+    captured.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameCapture::encoderLoop() {
+    if (format == CaptureFormat::Y4M) {
+        fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+    }
+
+    while (true) {
+        int index;
+        if (filledBuffers.pop(index)) {
+            if (writeFrame(buffers[index])) {
+                written.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            freeBuffers.push(index);
+            continue;
+        }
+
+        // Drain what is queued before honouring a stop
+        if (stopping.load(std::memory_order_acquire)) {
+            if (filledBuffers.isEmpty()) break;
+            continue;
+        }
+
+        // Sleep until a frame is queued or stop is called
+        SDL_SemWait(framesReady);
+    }
+
+    if (file) fflush(file);
+}
+
+bool FrameCapture::writeFrame(const std::vector<Uint32>& pixels) {
+    switch (format) {
+        case CaptureFormat::Y4M: {
+            Uint8* yPlane = yuv.data();
+            Uint8* uPlane = yPlane + static_cast<size_t>(width) * height;
+            Uint8* vPlane = uPlane + static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+            convertToI420(pixels.data(), width, height, yPlane, uPlane, vPlane);
+
+            return fputs("FRAME\n", file) >= 0 &&
+                   fwrite(yuv.data(), 1, yuv.size(), file) == yuv.size();
+        }
+
+        case CaptureFormat::RAW:
+            // ARGB8888 words are B, G, R, A bytes on little-endian machines
+            return fwrite(pixels.data(), sizeof(Uint32), pixels.size(), file) == pixels.size();
+
+        case CaptureFormat::PNG:
+        case CaptureFormat::BMP:
+            return writeImage(pixels);
+    }
+    return false;
+}
+
+bool FrameCapture::writeImage(const std::vector<Uint32>& pixels) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+        const_cast<Uint32*>(pixels.data()), width, height, 32,
+        width * static_cast<int>(sizeof(Uint32)), SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) return false;
+
+    std::string name = numberedPath(path, imageIndex++);
+    bool ok;
+#ifdef HAVE_SDL2_IMAGE
+    if (format == CaptureFormat::PNG) {
+        ok = IMG_SavePNG(surface, name.c_str()) == 0;
+    } else
+#endif
+    {
+        ok = SDL_SaveBMP(surface, name.c_str()) == 0;
+    }
+
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+void FrameCapture::convertToI420(const Uint32* argb, int width, int height,
+                                 Uint8* yPlane, Uint8* uPlane, Uint8* vPlane) {
+    const int chromaWidth = (width + 1) / 2;
+
+    for (int y = 0; y < height; y += 2) {
+        const Uint32* row0 = argb + static_cast<size_t>(y) * width;
+        const Uint32* row1 = (y + 1 < height) ? row0 + width : row0;
+        Uint8* y0 = yPlane + static_cast<size_t>(y) * width;
+        Uint8* y1 = (y + 1 < height) ? y0 + width : nullptr;
+        Uint8* u = uPlane + static_cast<size_t>(y / 2) * chromaWidth;
+        Uint8* v = vPlane + static_cast<size_t>(y / 2) * chromaWidth;
+
+        for (int x = 0; x < width; x += 2) {
+            int x1 = (x + 1 < width) ? x + 1 : x;
+            const Uint32 block[4] = {row0[x], row0[x1], row1[x], row1[x1]};
+
+            // Luma per pixel, chroma from the 2x2 average
+            int sumR = 0, sumG = 0, sumB = 0;
+            for (int i = 0; i < 4; ++i) {
+                int r = (block[i] >> 16) & 0xFF;
+                int g = (block[i] >> 8) & 0xFF;
+                int b = block[i] & 0xFF;
+                sumR += r;
+                sumG += g;
+                sumB += b;
+
+                Uint8 luma = clampByte((77 * r + 150 * g + 29 * b + 128) >> 8);
+                int px = (i & 1) ? x1 : x;
+                if (i < 2) {
+                    y0[px] = luma;
+                } else if (y1) {
+                    y1[px] = luma;
+                }
+            }
+
+            int r = (sumR + 2) >> 2;
+            int g = (sumG + 2) >> 2;
+            int b = (sumB + 2) >> 2;
+            u[x / 2] = clampByte(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128);
+            v[x / 2] = clampByte(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128);
+        }
+    }
+}
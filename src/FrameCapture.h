@@ -0,0 +1,106 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Constants.h"
+#include "SpscRing.h"
+
+class Renderer;
+
+// Output written by FrameCapture
+enum class CaptureFormat {
+    Y4M, // YUV4MPEG2 video, 4:2:0 (plays in mpv/ffplay, encodes with ffmpeg)
+    RAW, // Headerless BGRA frames (ffmpeg -f rawvideo -pix_fmt bgra)
+    PNG, // One numbered PNG per frame (needs SDL2_image)
+    BMP  // One numbered BMP per frame
+};
+
+// Capture counters; safe to read from the game thread while recording
+struct CaptureStats {
+    Uint64 captured; // Frames read back and queued
+    Uint64 dropped;  // Frames skipped because every buffer was busy
+    Uint64 written;  // Frames the encoder finished
+    Uint64 errors;   // Frames that could not be read back or written
+};
+
+// Records rendered frames without making the game wait for the disk.
+// The game thread copies each frame into one of a fixed pool of buffers
+// and hands it to an encoder thread through a lock-free ring; the encoder
+// converts and writes it, then returns the buffer through a second ring.
+// When the encoder falls behind and no buffer is free, the frame is
+// dropped and counted instead of waiting.
+class FrameCapture {
+public:
+    FrameCapture();
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Pick the format from the file extension (.y4m, .raw, .png, .bmp)
+    static bool formatForPath(const std::string& path, CaptureFormat* format);
+
+    // Open the output and start the encoder thread. Image sequences are
+    // numbered: "shots/frame.png" writes shots/frame_000000.png, ...
+    bool start(const std::string& path, int width, int height,
+               int fps = Constants::TARGET_FPS);
+
+    // Write the frames still queued, then stop the encoder thread
+    void stop();
+
+    bool isActive() const { return active; }
+
+    // Copy the frame the renderer has just drawn (call before present)
+    void captureFrame(Renderer& renderer);
+
+    CaptureStats getStats() const;
+
+    // BT.601 full-range ARGB8888 to planar 4:2:0 (chroma planes are
+    // ((width + 1) / 2) x ((height + 1) / 2))
+    static void convertToI420(const Uint32* argb, int width, int height,
+                              Uint8* yPlane, Uint8* uPlane, Uint8* vPlane);
+
+private:
+    static constexpr size_t RING_SIZE = 8;
+    static_assert(Constants::CAPTURE_BUFFER_COUNT <= static_cast<int>(RING_SIZE),
+                  "Every capture buffer must fit in the rings");
+
+    // Encoder thread
+    void encoderLoop();
+    bool writeFrame(const std::vector<Uint32>& pixels);
+    bool writeImage(const std::vector<Uint32>& pixels);
+
+    CaptureFormat format;
+    std::string path;
+    int width;
+    int height;
+    int fps;
+    FILE* file; // Video formats only
+    bool active;
+
+    // Buffer pool, handed back and forth by index
+    std::vector<std::vector<Uint32>> buffers;
+    SpscRing<int, RING_SIZE> freeBuffers;   // Encoder -> game
+    SpscRing<int, RING_SIZE> filledBuffers; // Game -> encoder
+    int heldBuffer; // Taken by the game thread but not queued (read failed)
+    SDL_sem* framesReady; // Posted for each filled buffer, and by stop
+
+    // Encoder scratch space
+    std::vector<Uint8> yuv;
+    Uint64 imageIndex;
+
+    std::thread encoder;
+    std::atomic<bool> stopping;
+
+    std::atomic<Uint64> captured;
+    std::atomic<Uint64> dropped;
+    std::atomic<Uint64> written;
+    std::atomic<Uint64> errors;
+};
+
+#endif // FRAMECAPTURE_H
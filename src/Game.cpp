@@ -1,9 +1,20 @@
 #include "Game.h"
+#include <algorithm>
 #include <cstdio>
+#include "AssetPack.h"
+
+namespace {
+
+// Fonts, audio, controller mappings and high scores
+constexpr int STARTUP_LOADS = 4;
+
+} // namespace
 
 Game::Game()
     : currentState(GameState::MENU)
     , running(false)
+    , loadsFinished(0)
+    , firstFramePresented(false)
     , numPlayers(1)
     , currentPlayer(1)
     , score(0)
@@ -11,6 +22,8 @@ Game::Game()
     , moveTimer(0)
     , foodEaten(0)
     , newHighScore(false)
+    , scoreRank(0)
+    , scoreCount(0)
     , frameStart(0)
     , frameTime(0) {
 }
@@ -19,7 +32,13 @@ Game::~Game() {
     shutdown();
 }
 
-bool Game::init() {
+bool Game::init(const GameOptions& options) {
+    timeline.start();
+
+    // Assets come from the pack built with the game; without one (e.g. a
+    // source checkout) they are read from the assets folder
+    timeline.time("asset pack", [] { return mountAssetPack(Constants::ASSET_PACK_PATH); });
+
     // Create components
     input = std::make_unique<InputManager>();
     renderer = std::make_unique<Renderer>();
@@ -27,40 +46,67 @@ bool Game::init() {
     highScores = std::make_unique<HighScoreManager>();
     menu = std::make_unique<Menu>();
 
-    // Initialize renderer first (creates window)
-    if (!renderer->init()) {
+    // Open the window first, so the loading screen shows while fonts,
+    // sounds, music, controller mappings and high scores load on workers
+    if (!timeline.time("window", [&] { return renderer->initWindow(options.renderBackend,
+                                                                     timeline); })) {
         printf("Error: Failed to initialize renderer\n");
         return false;
     }
+    if (options.fullscreen) {
+        renderer->setFullscreen(true);
+    }
+    renderer->setBoardRenderMode(options.boardRenderMode);
+    renderer->setBoardSize(options.boardWidth, options.boardHeight);
+    snake.setArena(options.boardWidth, options.boardHeight);
+    if (!options.skinName.empty()) {
+        renderer->loadSkin(options.skinName); // Swaps in when ready
+    }
+
+    // Start recording (optional - the game runs without it)
+    if (!options.recordPath.empty()) {
+        capture = std::make_unique<FrameCapture>();
+        if (!capture->start(options.recordPath, renderer->getOutputWidth(),
+                            renderer->getOutputHeight())) {
+            printf("Warning: Recording disabled\n");
+            capture.reset();
+        }
+    }
 
     // Initialize input
-    if (!input->init()) {
+    if (!input->initAsync(timeline)) {
         printf("Warning: Input initialization had issues\n");
         // Continue anyway - keyboard should still work
     }
 
     // Initialize audio (optional - game works without sound)
-    if (!audio->init()) {
+    audio->setBufferFrames(options.audioBufferFrames);
+    if (!timeline.time("audio device", [&] { return audio->initAsync(timeline); })) {
         printf("Warning: Audio initialization failed - continuing without sound\n");
     }
 
     // Load high scores
-    if (!highScores->load()) {
-        printf("Warning: Could not load high scores\n");
-    }
-
-    // Start background music
-    audio->playBackgroundMusic();
+    highScoreLoad = std::async(std::launch::async, [this] {
+        return timeline.time("high scores", [this] { return highScores->load(); });
+    });
 
     running = true;
-    currentState = GameState::MENU;
-    menu->setNumOptions(4);
+    currentState = GameState::LOADING;
 
     printf("Game initialized successfully!\n");
     return true;
 }
 
 void Game::shutdown() {
+    if (highScoreLoad.valid()) highScoreLoad.wait();
+
+    // Make sure the last score reached the disk
+    if (highScores) highScores->flush();
+
+    // Finish writing queued frames before the renderer goes away
+    if (capture) capture->stop();
+    capture.reset();
+
     if (audio) audio->shutdown();
     if (input) input->shutdown();
     if (renderer) renderer->shutdown();
@@ -71,11 +117,20 @@ void Game::shutdown() {
     highScores.reset();
     menu.reset();
 
+    // Fonts and music read from the pack until they are closed
+    unmountAssetPack();
+
     running = false;
 }
 
 void Game::run() {
     while (running) {
+        // Still screens sleep until input arrives or an animation is due;
+        // the frame after waking redraws them
+        if (isIdle()) {
+            input->waitForEvents(idleTimeout());
+        }
+
         frameStart = SDL_GetTicks();
 
         // Process input
@@ -84,6 +139,9 @@ void Game::run() {
             break;
         }
 
+        // Follow window size, fullscreen and lost textures
+        handleWindowChanges();
+
         // Update game state
         update();
 
@@ -101,9 +159,49 @@ void Game::run() {
     }
 }
 
+bool Game::isIdle() const {
+    // A recording needs every frame
+    if (capture) return false;
+
+    switch (currentState) {
+        case GameState::LOADING:
+        case GameState::PLAYING:
+            return false;
+        case GameState::PAUSED:
+            return true; // Effects are frozen too
+        default:
+            return particles.getCount() == 0; // Let an explosion finish
+    }
+}
+
+int Game::idleTimeout() const {
+    // Wake for the next blink of the initials cursor; nothing else on an
+    // idle screen moves by itself
+    if (currentState == GameState::ENTER_INITIALS) {
+        const Uint32 blink = Constants::CURSOR_BLINK_MS;
+        return static_cast<int>(blink - SDL_GetTicks() % blink);
+    }
+    return -1;
+}
+
+void Game::handleWindowChanges() {
+    if (input->isFullscreenToggled()) {
+        renderer->setFullscreen(!renderer->isFullscreen());
+    }
+    if (input->isOutputResized()) {
+        renderer->handleOutputResize();
+    }
+    if (input->isRenderReset()) {
+        renderer->handleRenderReset(input->isRenderDeviceLost());
+    }
+}
+
 void Game::setState(GameState newState) {
     currentState = newState;
 
+    // Recompose the board layer from scratch on the next playing frame
+    renderer->invalidateBoard();
+
     // State entry actions
     switch (newState) {
         case GameState::MENU:
@@ -135,7 +233,15 @@ void Game::setState(GameState newState) {
 }
 
 void Game::update() {
+    // Effects play on under every screen except the pause overlay
+    if (currentState != GameState::PAUSED) {
+        particles.update(1.0f / Constants::TARGET_FPS);
+    }
+
     switch (currentState) {
+        case GameState::LOADING:
+            updateLoading();
+            break;
         case GameState::MENU:
             updateMenu();
             break;
@@ -170,6 +276,9 @@ void Game::render() {
     renderer->clear();
 
     switch (currentState) {
+        case GameState::LOADING:
+            renderLoading();
+            break;
         case GameState::MENU:
             renderMenu();
             break;
@@ -200,11 +309,51 @@ void Game::render() {
             break;
     }
 
+    // Grab the frame before present (scanlines are not recorded)
+    if (capture) capture->captureFrame(*renderer);
+
     renderer->present();
+
+    if (!firstFramePresented) {
+        timeline.addMark("first frame");
+        firstFramePresented = true;
+    }
 }
 
 // === State Update Methods ===
 
+void Game::updateLoading() {
+    // Take whatever is done; the rest keeps loading behind the progress bar
+    int finished = 0;
+    if (renderer->finishLoading()) ++finished;
+    if (audio->finishLoading()) ++finished;
+    if (input->finishLoading()) ++finished;
+
+    if (isLoadFinished(highScoreLoad) && !highScoreLoad.get()) {
+        printf("Warning: Could not load high scores\n");
+    }
+    if (!highScoreLoad.valid()) ++finished;
+
+    loadsFinished = finished;
+
+    // Stay until the loading screen has been shown at least once, so the
+    // timeline always has a first frame before the game becomes interactive
+    if (loadsFinished < STARTUP_LOADS || !firstFramePresented) return;
+
+    if (!renderer->hasFonts()) {
+        printf("Error: Failed to initialize renderer\n");
+        running = false;
+        return;
+    }
+
+    timeline.addMark("interactive");
+    timeline.print();
+
+    // Start background music
+    audio->playBackgroundMusic();
+    setState(GameState::MENU);
+}
+
 void Game::updateMenu() {
     if (menu->handleInput(*input)) {
         int option = menu->getSelectedOption();
@@ -295,6 +444,11 @@ void Game::updatePlaying() {
         return;
     }
 
+    // Handle zoom input
+    if (input->getZoomInput() != 0) {
+        renderer->getCamera().zoom(input->getZoomInput());
+    }
+
     // Handle direction input
     Direction dir = input->getDirection();
     if (dir != Direction::NONE) {
@@ -324,6 +478,17 @@ void Game::updatePlaying() {
             foodEaten++;
             audio->playEatSound();
 
+            // Burst of food-colored sparks where it was eaten
+            SDL_Color foodColor = {
+                Constants::Colors::FOOD_R,
+                Constants::Colors::FOOD_G,
+                Constants::Colors::FOOD_B,
+                Constants::Colors::FOOD_A
+            };
+            particles.emit(food.getPosition().x + 0.5f, food.getPosition().y + 0.5f,
+                           Constants::EAT_PARTICLES, foodColor,
+                           Constants::EAT_PARTICLE_SPEED, Constants::EAT_PARTICLE_LIFE);
+
             // Speed up game
             if (foodEaten % Constants::SPEED_INCREASE_INTERVAL == 0) {
                 if (gameSpeed > Constants::MIN_GAME_SPEED) {
@@ -394,6 +559,10 @@ void Game::updateFinalResults() {
 
 // === State Render Methods ===
 
+void Game::renderLoading() {
+    renderer->drawLoadingScreen(static_cast<float>(loadsFinished) / STARTUP_LOADS);
+}
+
 void Game::renderMenu() {
     renderer->drawMenu(menu->getSelectedOption());
 }
@@ -407,9 +576,8 @@ void Game::renderEnterInitials() {
 }
 
 void Game::renderPlaying() {
-    renderer->drawGrid();
-    renderer->drawSnake(snake);
-    renderer->drawFood(food);
+    renderer->drawBoard(snake, food);
+    renderer->drawParticles(particles);
     renderer->drawScore(score, highScores->getTopScore());
 
     if (numPlayers == 2) {
@@ -422,7 +590,8 @@ void Game::renderPaused() {
 }
 
 void Game::renderGameOver() {
-    renderer->drawGameOver(score, newHighScore);
+    renderer->drawParticles(particles);
+    renderer->drawGameOver(score, newHighScore, scoreRank, scoreCount);
 }
 
 void Game::renderHighScores() {
@@ -451,25 +620,48 @@ void Game::startNewGame() {
 void Game::resetCurrentPlayer() {
     snake.reset();
     food.spawn(snake);
+    particles.clear();
 
     score = 0;
     gameSpeed = Constants::INITIAL_GAME_SPEED;
     moveTimer = 0;
     foodEaten = 0;
     newHighScore = false;
+    scoreRank = 0;
 }
 
 void Game::handleGameOver() {
     snake.setAlive(false);
 
+    // Blow the head apart where it crashed (a head that left the board
+    // explodes on the edge, where it can be seen)
+    Position head = snake.getHead();
+    float x = std::min(std::max(head.x, 0), snake.getArenaWidth() - 1) + 0.5f;
+    float y = std::min(std::max(head.y, 0), snake.getArenaHeight() - 1) + 0.5f;
+    SDL_Color headColor = {
+        Constants::Colors::HEAD_R,
+        Constants::Colors::HEAD_G,
+        Constants::Colors::HEAD_B,
+        Constants::Colors::HEAD_A
+    };
+    SDL_Color bodyColor = {
+        Constants::Colors::BODY_R,
+        Constants::Colors::BODY_G,
+        Constants::Colors::BODY_B,
+        Constants::Colors::BODY_A
+    };
+    particles.emit(x, y, Constants::DEATH_PARTICLES / 2, headColor,
+                   Constants::DEATH_PARTICLE_SPEED, Constants::DEATH_PARTICLE_LIFE);
+    particles.emit(x, y, Constants::DEATH_PARTICLES / 2, bodyColor,
+                   Constants::DEATH_PARTICLE_SPEED, Constants::DEATH_PARTICLE_LIFE);
+
     // Store score for current player
     players[currentPlayer - 1].score = score;
 
-    // Check and record high score
+    // Record the score; every one goes on the leaderboard
     newHighScore = highScores->isHighScore(score);
-    if (newHighScore) {
-        highScores->addScore(players[currentPlayer - 1].initials, score);
-    }
+    scoreRank = highScores->addScore(players[currentPlayer - 1].initials, score);
+    scoreCount = highScores->getScoreCount();
 
     setState(GameState::GAME_OVER);
 }
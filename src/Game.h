@@ -1,16 +1,21 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <future>
 #include <string>
 #include <memory>
 #include "Constants.h"
 #include "Snake.h"
 #include "Food.h"
+#include "ParticleSystem.h"
 #include "InputManager.h"
 #include "Renderer.h"
 #include "AudioManager.h"
 #include "HighScoreManager.h"
 #include "Menu.h"
+#include "Options.h"
+#include "FrameCapture.h"
+#include "StartupTimeline.h"
 
 struct PlayerData {
     std::string initials;
@@ -30,7 +35,7 @@ public:
     ~Game();
 
     // Initialize all game systems
-    bool init();
+    bool init(const GameOptions& options = GameOptions());
 
     // Main game loop
     void run();
@@ -43,7 +48,19 @@ private:
     void update();
     void render();
 
+    // Pass window and renderer events on to the renderer
+    void handleWindowChanges();
+
+    // Nothing on screen moves by itself: wait for events instead of
+    // drawing at the frame rate
+    bool isIdle() const;
+
+    // Longest wait before the idle screen must be drawn again (-1: until
+    // input arrives)
+    int idleTimeout() const;
+
     // State-specific update methods
+    void updateLoading();
     void updateMenu();
     void updatePlayerSelect();
     void updateEnterInitials();
@@ -55,6 +72,7 @@ private:
     void updateFinalResults();
 
     // State-specific render methods
+    void renderLoading();
     void renderMenu();
     void renderPlayerSelect();
     void renderEnterInitials();
@@ -80,15 +98,23 @@ private:
     std::unique_ptr<AudioManager> audio;
     std::unique_ptr<HighScoreManager> highScores;
     std::unique_ptr<Menu> menu;
+    std::unique_ptr<FrameCapture> capture; // Only while recording
 
     // Game objects
     Snake snake;
     Food food;
+    ParticleSystem particles; // Eat and death effects
 
     // Game state
     GameState currentState;
     bool running;
 
+    // Startup: assets load on worker threads behind the loading screen
+    StartupTimeline timeline;
+    std::future<bool> highScoreLoad;
+    int loadsFinished;          // Of the loads started by init
+    bool firstFramePresented;
+
     // Player data
     int numPlayers;
     int currentPlayer; // 1 or 2
@@ -100,6 +126,8 @@ private:
     int moveTimer;
     int foodEaten;
     bool newHighScore;
+    size_t scoreRank;   // Rank of this game's score among all scores, 0 if none
+    size_t scoreCount;  // Scores recorded, including this one
 
     // Frame timing
     Uint32 frameStart;
@@ -0,0 +1,182 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <cstdio>
+
+GlyphAtlas::GlyphAtlas()
+    : glyphs()
+    , backend(nullptr)
+    , texture(nullptr)
+    , lineHeight(0)
+    , scale(1) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    destroy();
+}
+
+void GlyphAtlas::destroy() {
+    if (texture) {
+        backend->destroyTexture(texture);
+        texture = nullptr;
+    }
+    kerning.clear();
+}
+
+bool GlyphAtlas::build(RenderBackend& backend, TTF_Font* font, int scale) {
+    destroy();
+    if (!font) return false;
+    this->backend = &backend;
+    this->scale = std::max(1, scale);
+
+    // Wider shelves for bigger glyphs keep the atlas about as tall
+    const int atlasWidth = ATLAS_WIDTH * this->scale;
+    lineHeight = (TTF_FontHeight(font) + this->scale - 1) / this->scale;
+
+    // Rasterize every glyph in white (color comes from the vertices) and
+    // lay them out left to right on fixed-height shelves
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* surfaces[NUM_GLYPHS] = {};
+    SDL_Rect slots[NUM_GLYPHS] = {};
+    int penX = 0;
+    int penY = 0;
+    int shelfHeight = 0;
+
+    for (int i = 0; i < NUM_GLYPHS; ++i) {
+        Uint16 ch = static_cast<Uint16>(FIRST_CHAR + i);
+        Glyph& glyph = glyphs[i];
+        glyph = Glyph();
+
+        int minX, maxX, minY, maxY, advance;
+        if (!TTF_GlyphIsProvided(font, ch) ||
+            TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &advance) < 0) {
+            continue;
+        }
+
+        glyph.present = true;
+        glyph.advance = advance;
+        glyph.xOffset = std::min(0, minX);
+
+        // Blank glyphs such as space only need their advance
+        SDL_Surface* surface = TTF_RenderGlyph_Solid(font, ch, white);
+        if (!surface) continue;
+
+        if (penX + surface->w > atlasWidth) {
+            penX = 0;
+            penY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+
+        surfaces[i] = surface;
+        slots[i] = {penX, penY, surface->w, surface->h};
+        glyph.width = surface->w;
+        glyph.height = surface->h;
+
+        penX += surface->w + PADDING;
+        shelfHeight = std::max(shelfHeight, surface->h);
+    }
+
+    int atlasHeight = std::max(1, penY + shelfHeight);
+
+    // Copy the glyphs onto one transparent surface; the colorkey of the
+    // solid renderer leaves the background pixels at zero alpha
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32,
+                                                        SDL_PIXELFORMAT_ARGB8888);
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, 0);
+        for (int i = 0; i < NUM_GLYPHS; ++i) {
+            if (surfaces[i]) {
+                SDL_Rect dest = slots[i];
+                SDL_BlitSurface(surfaces[i], nullptr, atlas, &dest);
+            }
+        }
+        texture = backend.createTextureFromSurface(atlas);
+        SDL_FreeSurface(atlas);
+    }
+
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) SDL_FreeSurface(surface);
+    }
+
+    if (!texture) {
+        printf("Warning: Could not create glyph atlas: %s\n", SDL_GetError());
+        return false;
+    }
+
+    backend.setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    for (int i = 0; i < NUM_GLYPHS; ++i) {
+        glyphs[i].uv = {
+            static_cast<float>(slots[i].x) / atlasWidth,
+            static_cast<float>(slots[i].y) / atlasHeight,
+            static_cast<float>(slots[i].w) / atlasWidth,
+            static_cast<float>(slots[i].h) / atlasHeight
+        };
+    }
+
+    // Precompute pair kerning so drawing never calls into FreeType
+    kerning.assign(NUM_GLYPHS * NUM_GLYPHS, 0);
+    for (int a = 0; a < NUM_GLYPHS; ++a) {
+        if (!glyphs[a].present) continue;
+        for (int b = 0; b < NUM_GLYPHS; ++b) {
+            if (!glyphs[b].present) continue;
+            kerning[a * NUM_GLYPHS + b] = static_cast<short>(TTF_GetFontKerningSizeGlyphs(
+                font, static_cast<Uint16>(FIRST_CHAR + a), static_cast<Uint16>(FIRST_CHAR + b)));
+        }
+    }
+
+    return true;
+}
+
+int GlyphAtlas::glyphIndex(unsigned char c) const {
+    if (c >= FIRST_CHAR && c <= LAST_CHAR && glyphs[c - FIRST_CHAR].present) {
+        return c - FIRST_CHAR;
+    }
+
+    int fallback = '?' - FIRST_CHAR;
+    return glyphs[fallback].present ? fallback : -1;
+}
+
+int GlyphAtlas::measureText(const std::string& text) const {
+    int pen = 0;
+    int prev = -1;
+
+    for (char c : text) {
+        int index = glyphIndex(static_cast<unsigned char>(c));
+        if (index < 0) continue;
+
+        if (prev >= 0 && !kerning.empty()) pen += kerning[prev * NUM_GLYPHS + index];
+        pen += glyphs[index].advance;
+        prev = index;
+    }
+
+    return (pen + scale - 1) / scale;
+}
+
+void GlyphAtlas::addText(RenderBatch& batch, const std::string& text, int x, int y,
+                         SDL_Color color) const {
+    // The pen advances in texture pixels; quads are placed in logical ones
+    const float toLogical = 1.0f / scale;
+    int pen = 0;
+    int prev = -1;
+
+    for (char c : text) {
+        int index = glyphIndex(static_cast<unsigned char>(c));
+        if (index < 0) continue;
+
+        if (prev >= 0 && !kerning.empty()) pen += kerning[prev * NUM_GLYPHS + index];
+
+        const Glyph& glyph = glyphs[index];
+        if (glyph.width > 0) {
+            SDL_FRect dest = {
+                x + (pen + glyph.xOffset) * toLogical,
+                static_cast<float>(y),
+                glyph.width * toLogical,
+                glyph.height * toLogical
+            };
+            batch.addTexturedRect(dest, glyph.uv, color);
+        }
+
+        pen += glyph.advance;
+        prev = index;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include "RenderBatch.h"
+
+// All printable ASCII glyphs of one font size, rasterized once into a single
+// texture. Strings are drawn as textured quads from the atlas, so drawing
+// text never creates surfaces or textures.
+//
+// A font opened at `scale` times its size can be built with that scale:
+// the glyphs keep their full resolution in the texture while measurements
+// and quads stay in logical pixels, for drawing into a target with the
+// same scale.
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Rasterize the font's glyphs and upload them to a texture
+    bool build(RenderBackend& backend, TTF_Font* font, int scale = 1);
+
+    // Release the texture
+    void destroy();
+
+    // Check if the atlas can be drawn from
+    bool isReady() const { return texture != nullptr; }
+
+    // Width in logical pixels of a string drawn with this atlas
+    int measureText(const std::string& text) const;
+
+    // Height of one line of text
+    int getLineHeight() const { return lineHeight; }
+
+    // Queue the quads for a string with its top-left corner at (x, y)
+    void addText(RenderBatch& batch, const std::string& text, int x, int y,
+                 SDL_Color color) const;
+
+    RenderTexture* getTexture() const { return texture; }
+
+private:
+    static constexpr int FIRST_CHAR = 32;  // Space
+    static constexpr int LAST_CHAR = 126;  // Tilde
+    static constexpr int NUM_GLYPHS = LAST_CHAR - FIRST_CHAR + 1;
+    static constexpr int ATLAS_WIDTH = 1024;
+    static constexpr int PADDING = 1;      // Gap between glyphs to avoid bleeding
+
+    // Glyph metrics are in texture pixels (logical pixels times scale)
+    struct Glyph {
+        SDL_FRect uv;  // Normalized texture coordinates
+        int xOffset;   // Left bearing relative to the pen position
+        int width;
+        int height;
+        int advance;
+        bool present;
+    };
+
+    // Atlas slot for a character (falls back to '?'), or -1
+    int glyphIndex(unsigned char c) const;
+
+    Glyph glyphs[NUM_GLYPHS];
+    std::vector<short> kerning; // NUM_GLYPHS x NUM_GLYPHS pair adjustments
+    RenderBackend* backend; // Owner of texture
+    RenderTexture* texture;
+    int lineHeight; // Logical pixels
+    int scale;      // Texture pixels per logical pixel
+};
+
+#endif // GLYPHATLAS_H
@@ -4,66 +4,126 @@
 #include <algorithm>
 #include <ctime>
 #include <cstdio>
+#include "JsonReader.h"
+
+namespace {
+
+// Quote a string for the file, escaping what JSON requires
+void writeString(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+            out << escape;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Whole contents of a file; false if it can't be opened
+bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+} // namespace
 
 HighScoreManager::HighScoreManager()
-    : filepath(Constants::HIGHSCORE_PATH) {
+    : store(Constants::SCORE_FILE_PATH)
+    , jsonPath(Constants::HIGHSCORE_PATH)
+    , journalPath(Constants::HIGHSCORE_JOURNAL_PATH) {
 }
 
 bool HighScoreManager::load() {
-    scores.clear();
+    bool ok = store.open();
+
+    // First start with the score file: bring in the scores older versions
+    // kept (a missing file just means no scores yet)
+    if (store.isNew()) {
+        std::string text;
+        std::vector<LeaderboardEntry> parsed;
+        int sequence = 0;
+        if (readFile(jsonPath, text)) {
+            ok = readJson(text, parsed, sequence) && ok;
+        }
+        if (readFile(journalPath, text)) {
+            replayJournal(text, sequence, parsed);
+        }
 
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        // File doesn't exist yet - that's okay
-        return true;
+        const size_t imported = parsed.size();
+        ok = store.replaceAll(std::move(parsed)) && ok;
+        if (imported > 0) {
+            printf("Imported %zu high scores from %s\n", imported, jsonPath.c_str());
+        }
+        std::remove(journalPath.c_str());
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string json = buffer.str();
-    file.close();
+    refreshTop();
+    return ok;
+}
 
-    return parseJson(json);
+bool HighScoreManager::flush() {
+    return store.flush();
 }
 
-bool HighScoreManager::save() {
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        printf("Error: Could not open high scores file for writing\n");
-        return false;
+void HighScoreManager::replayJournal(std::string_view text, int fileSequence,
+                                     std::vector<LeaderboardEntry>& parsed) {
+    size_t recovered = 0;
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        const size_t lineOffset = lineStart;
+        lineStart = lineEnd + 1;
+
+        JsonReader reader(line);
+        if (reader.atEnd()) continue;
+
+        // Records the JSON file already holds are skipped; a damaged line
+        // can only be the last one, cut off mid-write
+        int recordSequence = 0;
+        std::vector<LeaderboardEntry> entry;
+        if (!parseEntry(reader, entry, &recordSequence) || !reader.finish()) {
+            printf("Warning: High score journal is damaged at byte %zu: %s\n",
+                   lineOffset + reader.getErrorOffset(), reader.getError());
+            break;
+        }
+        if (recordSequence > fileSequence) {
+            parsed.insert(parsed.end(), entry.begin(), entry.end());
+            recovered += entry.size();
+        }
     }
 
-    file << toJson();
-    file.close();
-    return true;
+    if (recovered > 0) {
+        printf("Recovered %zu high scores from %s\n", recovered, journalPath.c_str());
+    }
 }
 
-int HighScoreManager::addScore(const std::string& initials, int score) {
+size_t HighScoreManager::addScore(const std::string& initials, int score) {
     if (score <= 0) return 0;
 
-    HighScoreEntry entry;
-    entry.initials = initials.substr(0, Constants::INITIALS_LENGTH);
-    entry.score = score;
-    entry.date = getCurrentDate();
-
     // Pad initials if too short
-    while (entry.initials.length() < Constants::INITIALS_LENGTH) {
-        entry.initials += ' ';
+    std::string padded = initials.substr(0, Constants::INITIALS_LENGTH);
+    while (padded.length() < Constants::INITIALS_LENGTH) {
+        padded += ' ';
     }
 
-    scores.push_back(entry);
-    sortAndTrim();
-
-    // Find the rank of this score
-    for (size_t i = 0; i < scores.size(); ++i) {
-        if (scores[i].score == score && scores[i].initials == entry.initials &&
-            scores[i].date == entry.date) {
-            save();
-            return static_cast<int>(i + 1);
-        }
-    }
+    // Saved in the background
+    store.add(Leaderboard::makeEntry(score, padded, getCurrentDate()));
+    refreshTop();
 
-    return 0; // Didn't make the high score list
+    return getRank(score);
 }
 
 bool HighScoreManager::isHighScore(int score) const {
@@ -77,26 +137,31 @@ bool HighScoreManager::isHighScore(int score) const {
     return score > scores.back().score;
 }
 
+size_t HighScoreManager::getRank(int score) const {
+    return store.countAbove(score) + 1;
+}
+
 int HighScoreManager::getTopScore() const {
     if (scores.empty()) return 0;
     return scores.front().score;
 }
 
 void HighScoreManager::clear() {
+    store.replaceAll(std::vector<LeaderboardEntry>());
     scores.clear();
-    save();
 }
 
-void HighScoreManager::sortAndTrim() {
-    // Sort by score (highest first)
-    std::sort(scores.begin(), scores.end(),
-              [](const HighScoreEntry& a, const HighScoreEntry& b) {
-                  return a.score > b.score;
-              });
+void HighScoreManager::refreshTop() {
+    std::vector<LeaderboardEntry> top10;
+    store.page(0, Constants::MAX_HIGH_SCORES, top10);
 
-    // Keep only top scores
-    if (scores.size() > Constants::MAX_HIGH_SCORES) {
-        scores.resize(Constants::MAX_HIGH_SCORES);
+    scores.clear();
+    for (const LeaderboardEntry& entry : top10) {
+        HighScoreEntry top;
+        top.initials = std::string(entry.getInitials());
+        top.score = entry.getScore();
+        top.date = std::string(entry.getDate());
+        scores.push_back(std::move(top));
     }
 }
 
@@ -113,87 +178,149 @@ std::string HighScoreManager::getCurrentDate() const {
     return std::string(buffer);
 }
 
-bool HighScoreManager::parseJson(const std::string& json) {
-    // Simple JSON parser for our specific format
-    // Format: {"scores":[{"initials":"AAA","score":100,"date":"2025-12-12"},...]}
+bool HighScoreManager::parseJson(std::string_view json) {
+    std::vector<LeaderboardEntry> parsed;
+    int sequence = 0;
+    if (!readJson(json, parsed, sequence)) return false;
 
-    size_t scoresStart = json.find("\"scores\"");
-    if (scoresStart == std::string::npos) return true; // Empty or invalid
+    store.addAll(std::move(parsed));
+    refreshTop();
+    return true;
+}
 
-    size_t arrayStart = json.find('[', scoresStart);
-    size_t arrayEnd = json.find(']', arrayStart);
-    if (arrayStart == std::string::npos || arrayEnd == std::string::npos) {
-        return true;
+bool HighScoreManager::importJson(const std::string& path) {
+    std::string text;
+    if (!readFile(path, text)) {
+        printf("Error: Could not open %s\n", path.c_str());
+        return false;
     }
 
-    std::string arrayContent = json.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
-
-    // Parse each entry
-    size_t pos = 0;
-    while (pos < arrayContent.length()) {
-        size_t objStart = arrayContent.find('{', pos);
-        size_t objEnd = arrayContent.find('}', objStart);
-        if (objStart == std::string::npos || objEnd == std::string::npos) break;
+    const size_t before = store.size();
+    if (!parseJson(text)) return false;
+    printf("Imported %zu high scores from %s\n", store.size() - before, path.c_str());
+    return true;
+}
 
-        std::string objContent = arrayContent.substr(objStart + 1, objEnd - objStart - 1);
+bool HighScoreManager::exportJson(const std::string& path) const {
+    bool written = HighScoreWriter::writeAtomically(path, [this](const HighScoreWriter::FileSink& sink) {
+        return writeJson(sink);
+    });
+    if (!written) {
+        printf("Error: Could not write %s\n", path.c_str());
+        return false;
+    }
 
-        HighScoreEntry entry;
+    printf("Exported %zu high scores to %s\n", store.size(), path.c_str());
+    return true;
+}
 
-        // Parse initials
-        size_t initialsPos = objContent.find("\"initials\"");
-        if (initialsPos != std::string::npos) {
-            size_t valueStart = objContent.find('\"', initialsPos + 10);
-            size_t valueEnd = objContent.find('\"', valueStart + 1);
-            if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                entry.initials = objContent.substr(valueStart + 1, valueEnd - valueStart - 1);
+bool HighScoreManager::readJson(std::string_view json, std::vector<LeaderboardEntry>& parsed,
+                                int& fileSequence) {
+    // Format: {"scores":[{"initials":"AAA","score":100,"date":"2025-12-12"},...]}
+    // Other fields, at any level, are skipped. "sequence" pairs the file
+    // with the journal older versions kept.
+    JsonReader reader(json);
+
+    if (!reader.atEnd()) {
+        std::string_view key;
+        reader.beginObject();
+        while (reader.nextKey(key)) {
+            if (key == "scores") {
+                parseScores(reader, parsed);
+            } else if (key == "sequence") {
+                reader.readInt(fileSequence);
+            } else {
+                reader.skipValue();
             }
         }
+        reader.finish();
+    }
 
-        // Parse score
-        size_t scorePos = objContent.find("\"score\"");
-        if (scorePos != std::string::npos) {
-            size_t valueStart = objContent.find(':', scorePos);
-            if (valueStart != std::string::npos) {
-                entry.score = std::stoi(objContent.substr(valueStart + 1));
-            }
-        }
+    if (reader.hasError()) {
+        printf("Warning: High scores file is damaged at byte %zu: %s\n",
+               reader.getErrorOffset(), reader.getError());
+        parsed.clear();
+        return false;
+    }
+    return true;
+}
 
-        // Parse date
-        size_t datePos = objContent.find("\"date\"");
-        if (datePos != std::string::npos) {
-            size_t valueStart = objContent.find('\"', datePos + 6);
-            size_t valueEnd = objContent.find('\"', valueStart + 1);
-            if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                entry.date = objContent.substr(valueStart + 1, valueEnd - valueStart - 1);
-            }
-        }
+bool HighScoreManager::parseScores(JsonReader& reader, std::vector<LeaderboardEntry>& parsed) {
+    if (!reader.beginArray()) return false;
+    while (reader.nextElement()) {
+        if (!parseEntry(reader, parsed)) return false;
+    }
+    return !reader.hasError();
+}
 
-        if (!entry.initials.empty() && entry.score > 0) {
-            scores.push_back(entry);
+bool HighScoreManager::parseEntry(JsonReader& reader, std::vector<LeaderboardEntry>& parsed,
+                                  int* recordSequence) {
+    HighScoreEntry entry;
+    entry.score = 0;
+
+    std::string_view key;
+    std::string_view text;
+    if (!reader.beginObject()) return false;
+    while (reader.nextKey(key)) {
+        if (key == "initials") {
+            if (!reader.readString(text)) return false;
+            JsonReader::decode(text, entry.initials);
+        } else if (key == "score") {
+            if (!reader.readInt(entry.score)) return false;
+        } else if (key == "date") {
+            if (!reader.readString(text)) return false;
+            JsonReader::decode(text, entry.date);
+        } else if (key == "sequence" && recordSequence) {
+            if (!reader.readInt(*recordSequence)) return false;
+        } else if (!reader.skipValue()) {
+            return false;
         }
-
-        pos = objEnd + 1;
     }
+    if (reader.hasError()) return false;
 
-    sortAndTrim();
+    if (!entry.initials.empty() && entry.score > 0) {
+        parsed.push_back(Leaderboard::makeEntry(entry.score, entry.initials, entry.date));
+    }
     return true;
 }
 
 std::string HighScoreManager::toJson() const {
+    std::string json;
+    writeJson([&json](const void* data, size_t size) {
+        json.append(static_cast<const char*>(data), size);
+        return true;
+    });
+    return json;
+}
+
+bool HighScoreManager::writeJson(const HighScoreWriter::FileSink& sink) const {
+    // Every score, best first, handed over a few thousand at a time
+    const size_t chunkSize = 4096;
     std::stringstream ss;
     ss << "{\n  \"scores\": [\n";
 
-    for (size_t i = 0; i < scores.size(); ++i) {
-        ss << "    {\"initials\": \"" << scores[i].initials
-           << "\", \"score\": " << scores[i].score
-           << ", \"date\": \"" << scores[i].date << "\"}";
+    size_t written = 0;
+    bool ok = true;
+    store.forEach([&](const LeaderboardEntry& entry) {
+        ss << "    {\"initials\": ";
+        writeString(ss, entry.getInitials());
+        ss << ", \"score\": " << entry.getScore() << ", \"date\": ";
+        writeString(ss, entry.getDate());
+        ss << "}";
 
-        if (i < scores.size() - 1) {
+        if (++written < store.size()) {
             ss << ",";
         }
         ss << "\n";
-    }
+
+        if (written % chunkSize == 0) {
+            const std::string chunk = ss.str();
+            ok = ok && sink(chunk.data(), chunk.size());
+            ss.str(std::string());
+        }
+    });
 
     ss << "  ]\n}";
-    return ss.str();
+    const std::string chunk = ss.str();
+    return ok && sink(chunk.data(), chunk.size());
 }
@@ -3,7 +3,12 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include "Constants.h"
+#include "Leaderboard.h"
+#include "ScoreStore.h"
+
+class JsonReader;
 
 struct HighScoreEntry {
     std::string initials;
@@ -15,47 +20,85 @@ struct HighScoreEntry {
     }
 };
 
+// The high score table. Every score is kept in the score file (see
+// ScoreStore); the best MAX_HIGH_SCORES are also kept ready for drawing.
+// Scores are saved in the background: nothing here waits for the disk
+// except load, flush, clear and the JSON import and export.
 class HighScoreManager {
 public:
     HighScoreManager();
     ~HighScoreManager() = default;
 
-    // Load high scores from file
+    // Open the score file. The first time, the scores older versions kept
+    // in highscores.json (and their journal) are imported.
     bool load();
 
-    // Save high scores to file
-    bool save();
+    // Wait for queued saves; false if one failed
+    bool flush();
 
-    // Add a new score (returns rank 1-10, or 0 if not a high score)
-    int addScore(const std::string& initials, int score);
+    // Add a new score; returns its rank among all scores (1 = best), or 0
+    // if it isn't a score
+    size_t addScore(const std::string& initials, int score);
 
-    // Check if a score qualifies as a high score
+    // Check if a score qualifies for the top MAX_HIGH_SCORES
     bool isHighScore(int score) const;
 
-    // Get all high scores
+    // Rank a score would have (1 + the scores above it)
+    size_t getRank(int score) const;
+
+    // Number of scores ever recorded
+    size_t getScoreCount() const { return store.size(); }
+
+    // The top MAX_HIGH_SCORES
     const std::vector<HighScoreEntry>& getScores() const { return scores; }
 
+    // Up to count scores from a position (0 = best), for paging through
+    void getPage(size_t position, size_t count, std::vector<LeaderboardEntry>& out) const {
+        store.page(position, count, out);
+    }
+
     // Get the highest score
     int getTopScore() const;
 
     // Clear all high scores
     void clear();
 
-private:
-    // Parse JSON manually (lightweight, no external dependencies)
-    bool parseJson(const std::string& json);
+    // Add the scores from high score JSON text. False (with a warning
+    // giving the byte offset) if it isn't valid; nothing is added then.
+    bool parseJson(std::string_view json);
 
-    // Generate JSON string
+    // Every score as JSON, in the highscores.json format
     std::string toJson() const;
 
+    // Add the scores in a JSON file, or write every score to one
+    bool importJson(const std::string& path);
+    bool exportJson(const std::string& path) const;
+
+private:
     // Get current date string (YYYY-MM-DD)
     std::string getCurrentDate() const;
 
-    // Sort and trim scores
-    void sortAndTrim();
+    // Copy the top of the table into scores
+    void refreshTop();
+
+    // Read high score JSON, and the journal older versions kept beside it
+    static bool readJson(std::string_view json, std::vector<LeaderboardEntry>& parsed,
+                         int& fileSequence);
+    void replayJournal(std::string_view text, int fileSequence,
+                       std::vector<LeaderboardEntry>& parsed);
+
+    // Read the "scores" array and one entry of it
+    static bool parseScores(JsonReader& reader, std::vector<LeaderboardEntry>& parsed);
+    static bool parseEntry(JsonReader& reader, std::vector<LeaderboardEntry>& parsed,
+                           int* recordSequence = nullptr);
+
+    // Write every score as JSON, a piece at a time
+    bool writeJson(const HighScoreWriter::FileSink& sink) const;
 
-    std::vector<HighScoreEntry> scores;
-    std::string filepath;
+    ScoreStore store;
+    std::vector<HighScoreEntry> scores; // Top of the table
+    std::string jsonPath;
+    std::string journalPath;
 };
 
 #endif // HIGHSCOREMANAGER_H
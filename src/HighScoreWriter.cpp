@@ -0,0 +1,334 @@
+#include "HighScoreWriter.h"
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+// A file that is mapped can't be replaced: the move waits for finishCompaction
+constexpr bool MOVE_OVER_MAPPED = false;
+
+int openForWrite(const std::string& path, bool append) {
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+    return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        int n = _write(fd, data + done, static_cast<unsigned>(size - done));
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+long long endOf(int fd) {
+    return _lseeki64(fd, 0, SEEK_END);
+}
+
+bool truncateTo(int fd, long long size) {
+    return _chsize_s(fd, size) == 0;
+}
+
+bool syncAndClose(int fd) {
+    bool synced = _commit(fd) == 0;
+    return _close(fd) == 0 && synced;
+}
+
+// Write-through makes the rename itself durable
+bool replaceFile(const std::string& from, const std::string& to) {
+    return MoveFileExA(from.c_str(), to.c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+void syncDirectoryOf(const std::string&) {
+}
+#else
+// The old contents stay mapped until unmapped
+constexpr bool MOVE_OVER_MAPPED = true;
+
+int openForWrite(const std::string& path, bool append) {
+    int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+    return ::open(path.c_str(), flags, 0644);
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::write(fd, data + done, size - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+long long endOf(int fd) {
+    return static_cast<long long>(lseek(fd, 0, SEEK_END));
+}
+
+bool truncateTo(int fd, long long size) {
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+bool syncAndClose(int fd) {
+    bool synced = fsync(fd) == 0;
+    return ::close(fd) == 0 && synced;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+    return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+// A rename is only durable once the directory holding it is synced
+void syncDirectoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+#endif
+
+} // namespace
+
+HighScoreWriter::HighScoreWriter(const std::string& path)
+    : path(path)
+    , pendingAppends(0)
+    , laterAppends(0)
+    , compacting(false)
+    , movePending(false)
+    , moveRequested(false)
+    , moved(false)
+    , busy(false)
+    , failed(false)
+    , stopping(false)
+    , writes(0)
+    , coalesced(0) {
+}
+
+HighScoreWriter::~HighScoreWriter() {
+    stop();
+}
+
+bool HighScoreWriter::writeAtomically(const std::string& path, const std::string& contents) {
+    return writeAtomically(path, [&contents](const FileSink& sink) {
+        return sink(contents.data(), contents.size());
+    });
+}
+
+bool HighScoreWriter::writeAtomically(const std::string& path,
+                                      const std::function<bool(const FileSink&)>& fill) {
+    const std::string temp = path + ".tmp";
+
+    int fd = openForWrite(temp, false);
+    if (fd < 0) return false;
+
+    bool written = fill([fd](const void* data, size_t size) {
+        return writeAll(fd, static_cast<const char*>(data), size);
+    });
+    if (!syncAndClose(fd) || !written || !replaceFile(temp, path)) {
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    syncDirectoryOf(path);
+    return true;
+}
+
+bool HighScoreWriter::appendSynced(const std::string& path, const std::string& data) {
+    int fd = openForWrite(path, true);
+    if (fd < 0) return false;
+
+    // A short write would leave part of a record for the next append to
+    // follow, so take it back off
+    const long long start = endOf(fd);
+    bool written = start >= 0 && writeAll(fd, data.data(), data.size());
+    if (!written && start >= 0) truncateTo(fd, start);
+    return syncAndClose(fd) && written;
+}
+
+bool HighScoreWriter::replace(const std::string& from, const std::string& to) {
+    if (!replaceFile(from, to)) return false;
+    syncDirectoryOf(to);
+    return true;
+}
+
+void HighScoreWriter::append(std::string data) {
+    if (!writer.joinable()) {
+        stopping = false;
+        writer = std::thread(&HighScoreWriter::writerLoop, this);
+    }
+
+    {
+        // The compaction must cover exactly the appends queued before it
+        std::lock_guard<std::mutex> lock(mutex);
+        if (compacting) {
+            laterData += data;
+            ++laterAppends;
+        } else {
+            pendingData += data;
+            ++pendingAppends;
+        }
+    }
+    wake.notify_one();
+}
+
+bool HighScoreWriter::compact(Rewrite rewrite) {
+    if (!writer.joinable()) {
+        stopping = false;
+        writer = std::thread(&HighScoreWriter::writerLoop, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (compacting || movePending || moved) return false;
+        pendingRewrite = std::move(rewrite);
+        compacting = true;
+    }
+    wake.notify_one();
+    return true;
+}
+
+bool HighScoreWriter::takeCompacted() {
+    std::lock_guard<std::mutex> lock(mutex);
+    const bool taken = moved;
+    moved = false;
+    return taken;
+}
+
+bool HighScoreWriter::isMovePending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return movePending;
+}
+
+void HighScoreWriter::finishCompaction() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!movePending) return;
+
+    moveRequested = true;
+    wake.notify_one();
+    idle.wait(lock, [this] { return !moveRequested && !busy; });
+}
+
+bool HighScoreWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] {
+        return pendingData.empty() && laterData.empty() && !compacting && !moveRequested && !busy;
+    });
+
+    bool ok = !failed;
+    failed = false;
+    return ok;
+}
+
+void HighScoreWriter::stop() {
+    if (!writer.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+void HighScoreWriter::writerLoop() {
+    const std::string compactedPath = getCompactedPath();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] {
+            return stopping || !pendingData.empty() || pendingRewrite || moveRequested;
+        });
+        if (pendingData.empty() && !pendingRewrite && !moveRequested) break; // Stopping, nothing left
+
+        // Take the whole batch: the appends, then any compaction after them
+        std::string data;
+        data.swap(pendingData);
+        const size_t appends = pendingAppends;
+        pendingAppends = 0;
+        Rewrite rewrite;
+        rewrite.swap(pendingRewrite);
+        const bool moveRequestedNow = moveRequested;
+        bool waiting = movePending;
+        busy = true;
+        lock.unlock();
+
+        bool ok = true;
+        if (!data.empty()) {
+            if (appendSynced(path, data)) {
+                writes.fetch_add(1, std::memory_order_relaxed);
+                coalesced.fetch_add(appends - 1, std::memory_order_relaxed);
+            } else {
+                printf("Error: Could not save high scores to %s\n", path.c_str());
+                ok = false;
+            }
+
+            // A compaction waiting to be moved must keep up with the file
+            if (waiting && (!ok || !appendSynced(compactedPath, data))) {
+                std::remove(compactedPath.c_str());
+                waiting = false;
+            }
+        }
+
+        bool move = moveRequestedNow;
+        if (rewrite) {
+            if (writeAtomically(compactedPath, [&](const FileSink& sink) {
+                    return rewrite(path, sink);
+                })) {
+                waiting = true;
+                move = move || MOVE_OVER_MAPPED;
+            } else {
+                printf("Error: Could not compact %s\n", path.c_str());
+                ok = false;
+            }
+        }
+
+        // Nothing else writes the file, so it and the compacted one match
+        bool replaced = false;
+        if (waiting && move) {
+            replaced = replace(compactedPath, path);
+            if (!replaced) {
+                printf("Error: Could not move %s over %s\n", compactedPath.c_str(), path.c_str());
+                std::remove(compactedPath.c_str());
+                ok = false;
+            }
+            waiting = false;
+        }
+
+        lock.lock();
+        if (rewrite) {
+            pendingData.swap(laterData);
+            pendingAppends = laterAppends;
+            laterAppends = 0;
+            compacting = false;
+        }
+        if (moveRequestedNow) moveRequested = false;
+        movePending = waiting;
+        moved = moved || replaced;
+        busy = false;
+        failed = failed || !ok;
+        idle.notify_all();
+    }
+}
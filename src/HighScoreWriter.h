@@ -0,0 +1,116 @@
+#ifndef HIGHSCOREWRITER_H
+#define HIGHSCOREWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Writes the score file on a background thread, so a slow disk never holds
+// up the game. Queuing only appends to a string under a short lock.
+//
+// New scores are appended to the end of the file. Appends are coalesced:
+// everything queued while the thread was busy goes out in one write and
+// one sync, so a burst of scores costs one sync.
+//
+// Compaction rewrites the whole file, after the appends queued before it,
+// into path + ".new" and moves that over the file, all on the writer
+// thread. The file itself always holds every score, so a crash at any
+// point loses nothing; a ".new" left behind can be deleted.
+//
+// Windows can't move a file over one that is mapped, so there the move
+// waits for finishCompaction, and appends go to both files until then.
+class HighScoreWriter {
+public:
+    // Receives a file's contents a piece at a time; false on a write error
+    using FileSink = std::function<bool(const void* data, size_t size)>;
+
+    // Writes the compacted contents of the file at a path
+    using Rewrite = std::function<bool(const std::string& path, const FileSink& sink)>;
+
+    explicit HighScoreWriter(const std::string& path);
+    ~HighScoreWriter();
+
+    HighScoreWriter(const HighScoreWriter&) = delete;
+    HighScoreWriter& operator=(const HighScoreWriter&) = delete;
+
+    // Queue bytes for the end of the file. Starts the writer thread if needed.
+    void append(std::string data);
+
+    // Queue a compaction. False (and ignored) while one is queued, waiting
+    // to be moved or moved but not yet taken.
+    bool compact(Rewrite rewrite);
+
+    // True once after each compaction is moved into place: the file's
+    // contents changed, so a mapping of it must be redone
+    bool takeCompacted();
+
+    // True while a compaction waits for finishCompaction (Windows only)
+    bool isMovePending();
+
+    // Move a waiting compaction into place; nothing may have the file
+    // mapped. A failed move is dropped: the file still has every score.
+    void finishCompaction();
+
+    // Wait until everything queued is on disk. False if a write failed
+    // since the last flush.
+    bool flush();
+
+    // Write what is still queued, then stop the thread
+    void stop();
+
+    // Syncs done, and appends that shared a sync with an earlier one
+    uint64_t getWrites() const { return writes.load(std::memory_order_relaxed); }
+    uint64_t getCoalesced() const { return coalesced.load(std::memory_order_relaxed); }
+
+    // Path the compacted file is written to
+    std::string getCompactedPath() const { return path + ".new"; }
+
+    // Replace a file's contents so that a crash leaves the old or the new
+    // contents whole. Safe to call from any thread.
+    static bool writeAtomically(const std::string& path, const std::string& contents);
+
+    // Same, with the contents produced by fill, for files too big to build
+    // in memory first
+    static bool writeAtomically(const std::string& path,
+                                const std::function<bool(const FileSink&)>& fill);
+
+    // Append to a file (creating it) and sync it
+    static bool appendSynced(const std::string& path, const std::string& data);
+
+    // Move a file over another, durably
+    static bool replace(const std::string& from, const std::string& to);
+
+private:
+    void writerLoop();
+
+    std::string path;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wake; // Work queued, or stopping
+    std::condition_variable idle; // A batch finished
+
+    // Guarded by mutex
+    std::string pendingData;
+    size_t pendingAppends;
+    std::string laterData;       // Appended after the queued compaction
+    size_t laterAppends;
+    Rewrite pendingRewrite;
+    bool compacting;             // Queued or running
+    bool movePending;            // Written, waiting for finishCompaction
+    bool moveRequested;          // finishCompaction is waiting for the move
+    bool moved;                  // Moved into place, not yet taken
+    bool busy;
+    bool failed;
+    bool stopping;
+
+    std::atomic<uint64_t> writes;
+    std::atomic<uint64_t> coalesced;
+};
+
+#endif // HIGHSCOREWRITER_H
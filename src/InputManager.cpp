@@ -1,6 +1,8 @@
 #include "InputManager.h"
+#include <algorithm>
 #include <cstdio>
 #include <cctype>
+#include "AssetPack.h"
 
 InputManager::InputManager()
     : currentAction(InputAction::NONE)
@@ -9,6 +11,11 @@ InputManager::InputManager()
     , backPressed(false)
     , pausePressed(false)
     , quitRequested(false)
+    , zoomInput(0)
+    , fullscreenToggled(false)
+    , outputResized(false)
+    , renderReset(false)
+    , renderDeviceLost(false)
     , textInput('\0') {
 }
 
@@ -27,17 +34,66 @@ bool InputManager::init() {
     loadControllerMappings();
 
     // Open any already-connected controllers
+    openConnectedControllers();
+
+    return true;
+}
+
+bool InputManager::initAsync(StartupTimeline& timeline) {
+    if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) < 0) {
+        printf("Warning: Could not initialize game controller: %s\n", SDL_GetError());
+    }
+
+    // Only the file is read off the main thread; SDL gets the text later
+    mappingLoad = std::async(std::launch::async, [&timeline] {
+        return timeline.time("controller mappings", [] {
+            std::string database;
+            SDL_RWops* rw = openAsset(Constants::CONTROLLER_DB_PATH);
+            if (!rw) return database;
+
+            Sint64 length = SDL_RWsize(rw);
+            if (length > 0) {
+                database.resize(static_cast<size_t>(length));
+                database.resize(SDL_RWread(rw, &database[0], 1, database.size()));
+            }
+            SDL_RWclose(rw);
+            return database;
+        });
+    });
+    return true;
+}
+
+bool InputManager::finishLoading() {
+    if (!mappingLoad.valid()) return true;
+    if (!isLoadFinished(mappingLoad)) return false;
+
+    addControllerMappings(mappingLoad.get());
+    openConnectedControllers();
+    return true;
+}
+
+void InputManager::addControllerMappings(const std::string& database) {
+    if (database.empty()) return;
+
+    SDL_RWops* rw = SDL_RWFromConstMem(database.data(), static_cast<int>(database.size()));
+    int mappingsAdded = SDL_GameControllerAddMappingsFromRW(rw, 1);
+    if (mappingsAdded > 0) {
+        printf("Loaded %d controller mappings\n", mappingsAdded);
+    }
+}
+
+void InputManager::openConnectedControllers() {
     int numJoysticks = SDL_NumJoysticks();
     for (int i = 0; i < numJoysticks; ++i) {
         if (SDL_IsGameController(i)) {
             addController(i);
         }
     }
-
-    return true;
 }
 
 void InputManager::shutdown() {
+    if (mappingLoad.valid()) mappingLoad.wait();
+
     // Close all controllers
     for (auto* controller : controllers) {
         if (controller) {
@@ -49,21 +105,30 @@ void InputManager::shutdown() {
 
 void InputManager::loadControllerMappings() {
     // Try to load additional controller mappings
-    int mappingsAdded = SDL_GameControllerAddMappingsFromFile(Constants::CONTROLLER_DB_PATH);
+    SDL_RWops* rw = openAsset(Constants::CONTROLLER_DB_PATH);
+    if (!rw) return;
+
+    int mappingsAdded = SDL_GameControllerAddMappingsFromRW(rw, 1);
     if (mappingsAdded > 0) {
         printf("Loaded %d controller mappings\n", mappingsAdded);
     }
 }
 
 void InputManager::addController(int deviceIndex) {
-    if (SDL_IsGameController(deviceIndex)) {
-        SDL_GameController* controller = SDL_GameControllerOpen(deviceIndex);
-        if (controller) {
-            controllers.push_back(controller);
-            const char* name = SDL_GameControllerName(controller);
-            printf("Controller connected: %s\n", name ? name : "Unknown");
-        }
+    if (!SDL_IsGameController(deviceIndex)) return;
+
+    SDL_GameController* controller = SDL_GameControllerOpen(deviceIndex);
+    if (!controller) return;
+
+    // Already open (plugged in while the mappings were loading)
+    if (std::find(controllers.begin(), controllers.end(), controller) != controllers.end()) {
+        SDL_GameControllerClose(controller);
+        return;
     }
+
+    controllers.push_back(controller);
+    const char* name = SDL_GameControllerName(controller);
+    printf("Controller connected: %s\n", name ? name : "Unknown");
 }
 
 void InputManager::removeController(SDL_JoystickID instanceId) {
@@ -111,6 +176,19 @@ bool InputManager::processEvents() {
                 handleTextInputEvent(event);
                 break;
 
+            case SDL_WINDOWEVENT:
+                handleWindowEvent(event);
+                break;
+
+            case SDL_RENDER_TARGETS_RESET:
+                renderReset = true;
+                break;
+
+            case SDL_RENDER_DEVICE_RESET:
+                renderReset = true;
+                renderDeviceLost = true;
+                break;
+
             default:
                 break;
         }
@@ -119,6 +197,11 @@ bool InputManager::processEvents() {
     return true;
 }
 
+bool InputManager::waitForEvents(int timeoutMs) {
+    // A null event only peeks, so nothing is taken out of the queue
+    return SDL_WaitEventTimeout(nullptr, timeoutMs) == 1;
+}
+
 void InputManager::handleKeyboardEvent(const SDL_Event& event) {
     switch (event.key.keysym.sym) {
         // Direction keys - WASD
@@ -165,6 +248,23 @@ void InputManager::handleKeyboardEvent(const SDL_Event& event) {
             pausePressed = true;
             break;
 
+        // Zoom (+/-)
+        case SDLK_EQUALS:
+        case SDLK_PLUS:
+        case SDLK_KP_PLUS:
+            ++zoomInput;
+            break;
+
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS:
+            --zoomInput;
+            break;
+
+        // Fullscreen (F11)
+        case SDLK_F11:
+            fullscreenToggled = true;
+            break;
+
         // Backspace for initials entry
         case SDLK_BACKSPACE:
             textInput = '\b'; // Use backspace character as signal
@@ -222,6 +322,15 @@ void InputManager::handleControllerButtonEvent(const SDL_Event& event) {
             selectPressed = true;
             break;
 
+        // Shoulder buttons (zoom)
+        case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER:
+            ++zoomInput;
+            break;
+
+        case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+            --zoomInput;
+            break;
+
         default:
             break;
     }
@@ -281,9 +390,26 @@ void InputManager::handleTextInputEvent(const SDL_Event& event) {
     }
 }
 
+void InputManager::handleWindowEvent(const SDL_Event& event) {
+    switch (event.window.event) {
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+        case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+            outputResized = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
 void InputManager::clearFrameFlags() {
     selectPressed = false;
     backPressed = false;
     pausePressed = false;
+    zoomInput = 0;
+    fullscreenToggled = false;
+    outputResized = false;
+    renderReset = false;
+    renderDeviceLost = false;
     currentDirection = Direction::NONE;
 }
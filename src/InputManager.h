@@ -2,9 +2,12 @@
 #define INPUTMANAGER_H
 
 #include <SDL2/SDL.h>
+#include <future>
+#include <string>
 #include <vector>
 #include <memory>
 #include "Constants.h"
+#include "StartupTimeline.h"
 
 class InputManager {
 public:
@@ -14,6 +17,15 @@ public:
     // Initialize input system
     bool init();
 
+    // Like init, but read the controller database on a loader thread.
+    // Keyboard input works at once; controllers that need a mapping from
+    // the database are opened by finishLoading.
+    bool initAsync(StartupTimeline& timeline);
+
+    // Apply the database once it has been read; never waits. True once
+    // nothing is left loading.
+    bool finishLoading();
+
     // Shutdown input system
     void shutdown();
 
@@ -21,6 +33,10 @@ public:
     // Returns false if quit event received
     bool processEvents();
 
+    // Sleep until an event is queued (left for processEvents) or the
+    // timeout passes (-1: no timeout). Returns true if an event is waiting.
+    bool waitForEvents(int timeoutMs);
+
     // Get the current input action (for menus)
     InputAction getAction() const { return currentAction; }
 
@@ -33,6 +49,15 @@ public:
     bool isPausePressed() const { return pausePressed; }
     bool isQuitRequested() const { return quitRequested; }
 
+    // Zoom steps requested this frame (+ in, - out)
+    int getZoomInput() const { return zoomInput; }
+
+    // Window and display changes this frame
+    bool isFullscreenToggled() const { return fullscreenToggled; }
+    bool isOutputResized() const { return outputResized; }       // Size or display changed
+    bool isRenderReset() const { return renderReset; }           // Render targets lost
+    bool isRenderDeviceLost() const { return renderDeviceLost; } // All textures lost
+
     // Get text input for initials entry
     char getTextInput() const { return textInput; }
     bool hasTextInput() const { return textInput != '\0'; }
@@ -50,6 +75,7 @@ private:
     void handleControllerAxisEvent(const SDL_Event& event);
     void handleControllerDeviceEvent(const SDL_Event& event);
     void handleTextInputEvent(const SDL_Event& event);
+    void handleWindowEvent(const SDL_Event& event);
 
     // Add a controller
     void addController(int deviceIndex);
@@ -60,6 +86,15 @@ private:
     // Load controller mappings from database file
     void loadControllerMappings();
 
+    // Add mappings from the contents of a database file
+    void addControllerMappings(const std::string& database);
+
+    // Open every controller already plugged in
+    void openConnectedControllers();
+
+    // Controller database being read by initAsync
+    std::future<std::string> mappingLoad;
+
     // Connected game controllers
     std::vector<SDL_GameController*> controllers;
 
@@ -72,6 +107,13 @@ private:
     bool backPressed;
     bool pausePressed;
     bool quitRequested;
+    int zoomInput;
+
+    // Window and renderer events
+    bool fullscreenToggled;
+    bool outputResized;
+    bool renderReset;
+    bool renderDeviceLost;
 
     // Text input
     char textInput;
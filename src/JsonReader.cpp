@@ -0,0 +1,329 @@
+#include "JsonReader.h"
+#include <climits>
+
+namespace {
+
+// Containers skipValue follows before giving up, so hostile files can't
+// exhaust the stack
+const int MAX_DEPTH = 64;
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUtf8(std::string& out, unsigned long code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// The four hex digits of a \u escape starting at raw[i]; -1 if short
+long readHex4(std::string_view raw, size_t i) {
+    if (i + 4 > raw.size()) return -1;
+    long code = 0;
+    for (size_t j = i; j < i + 4; ++j) {
+        int digit = hexValue(raw[j]);
+        if (digit < 0) return -1;
+        code = code * 16 + digit;
+    }
+    return code;
+}
+
+} // namespace
+
+JsonReader::JsonReader(std::string_view text)
+    : text(text)
+    , pos(0)
+    , afterValue(false)
+    , depth(0)
+    , error(nullptr)
+    , errorOffset(0) {
+}
+
+bool JsonReader::fail(const char* message) {
+    if (!error) {
+        error = message;
+        errorOffset = pos;
+    }
+    return false;
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        ++pos;
+    }
+}
+
+bool JsonReader::expect(char c, const char* message) {
+    if (error) return false;
+    skipWhitespace();
+    if (pos >= text.size() || text[pos] != c) return fail(message);
+    ++pos;
+    return true;
+}
+
+bool JsonReader::atEnd() {
+    skipWhitespace();
+    return pos >= text.size();
+}
+
+bool JsonReader::beginObject() {
+    if (!expect('{', "expected '{'")) return false;
+    afterValue = false;
+    return true;
+}
+
+bool JsonReader::beginArray() {
+    if (!expect('[', "expected '['")) return false;
+    afterValue = false;
+    return true;
+}
+
+bool JsonReader::nextMember(char close) {
+    if (error) return false;
+    skipWhitespace();
+    if (pos >= text.size()) return fail("unexpected end of file");
+
+    if (text[pos] == close) {
+        ++pos;
+        afterValue = true; // The container was a value of its parent
+        return false;
+    }
+
+    if (afterValue) {
+        if (text[pos] != ',') {
+            return fail(close == '}' ? "expected ',' or '}'" : "expected ',' or ']'");
+        }
+        ++pos;
+        skipWhitespace();
+        if (pos < text.size() && text[pos] == close) return fail("trailing comma");
+    }
+    afterValue = false;
+    return true;
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+    if (!nextMember('}')) return false;
+    if (!readString(key) || !expect(':', "expected ':'")) return false;
+    afterValue = false;
+    return true;
+}
+
+bool JsonReader::nextElement() {
+    return nextMember(']');
+}
+
+bool JsonReader::readString(std::string_view& value) {
+    if (!expect('"', "expected a string")) return false;
+
+    // Escapes are checked here and left in place; decode expands them
+    const size_t start = pos;
+    while (pos < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[pos]);
+        if (c == '"') {
+            value = text.substr(start, pos - start);
+            ++pos;
+            afterValue = true;
+            return true;
+        }
+        if (c < 0x20) return fail("control character in string");
+
+        if (c == '\\') {
+            ++pos;
+            if (pos >= text.size()) break;
+            switch (text[pos]) {
+                case '"': case '\\': case '/':
+                case 'b': case 'f': case 'n': case 'r': case 't':
+                    break;
+                case 'u':
+                    if (readHex4(text, pos + 1) < 0) return fail("bad \\u escape");
+                    pos += 4;
+                    break;
+                default:
+                    return fail("bad escape in string");
+            }
+        }
+        ++pos;
+    }
+    return fail("unterminated string");
+}
+
+bool JsonReader::readInt(int& value) {
+    if (error) return false;
+    skipWhitespace();
+
+    const size_t start = pos;
+    const bool negative = pos < text.size() && text[pos] == '-';
+    if (negative) ++pos;
+    if (pos >= text.size() || !isDigit(text[pos])) {
+        pos = start;
+        return fail("expected an integer");
+    }
+
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    long long number = 0;
+    while (pos < text.size() && isDigit(text[pos])) {
+        number = number * 10 + (text[pos] - '0');
+        if (number > limit) {
+            pos = start;
+            return fail("number out of range");
+        }
+        ++pos;
+    }
+    if (pos < text.size() && (text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E')) {
+        pos = start;
+        return fail("expected an integer");
+    }
+
+    value = static_cast<int>(negative ? -number : number);
+    afterValue = true;
+    return true;
+}
+
+bool JsonReader::skipNumber() {
+    const size_t start = pos;
+    auto digits = [this] {
+        const size_t first = pos;
+        while (pos < text.size() && isDigit(text[pos])) ++pos;
+        return pos > first;
+    };
+
+    if (pos < text.size() && text[pos] == '-') ++pos;
+    bool valid = digits();
+    if (valid && pos < text.size() && text[pos] == '.') {
+        ++pos;
+        valid = digits();
+    }
+    if (valid && pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) ++pos;
+        valid = digits();
+    }
+
+    if (!valid) {
+        pos = start;
+        return fail("expected a value");
+    }
+    afterValue = true;
+    return true;
+}
+
+bool JsonReader::skipLiteral(std::string_view literal) {
+    if (text.compare(pos, literal.size(), literal) != 0) return fail("expected a value");
+    pos += literal.size();
+    afterValue = true;
+    return true;
+}
+
+bool JsonReader::skipValue() {
+    if (error) return false;
+    skipWhitespace();
+    if (pos >= text.size()) return fail("expected a value");
+
+    switch (text[pos]) {
+        case '{': {
+            if (depth >= MAX_DEPTH) return fail("nested too deeply");
+            ++depth;
+            std::string_view key;
+            beginObject();
+            while (nextKey(key)) {
+                if (!skipValue()) return false;
+            }
+            --depth;
+            return !error;
+        }
+        case '[':
+            if (depth >= MAX_DEPTH) return fail("nested too deeply");
+            ++depth;
+            beginArray();
+            while (nextElement()) {
+                if (!skipValue()) return false;
+            }
+            --depth;
+            return !error;
+        case '"': {
+            std::string_view value;
+            return readString(value);
+        }
+        case 't':
+            return skipLiteral("true");
+        case 'f':
+            return skipLiteral("false");
+        case 'n':
+            return skipLiteral("null");
+        default:
+            return skipNumber();
+    }
+}
+
+bool JsonReader::finish() {
+    if (error) return false;
+    if (!atEnd()) return fail("unexpected data after the end");
+    return true;
+}
+
+void JsonReader::decode(std::string_view raw, std::string& out) {
+    // Most strings have no escapes and copy across whole
+    if (raw.find('\\') == std::string_view::npos) {
+        out.assign(raw.data(), raw.size());
+        return;
+    }
+
+    out.clear();
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] != '\\' || i + 1 >= raw.size()) {
+            out += raw[i];
+            continue;
+        }
+
+        const char escape = raw[++i];
+        switch (escape) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                long code = readHex4(raw, i + 1);
+                if (code < 0) break;
+                i += 4;
+
+                // A surrogate pair spells one character outside the BMP
+                if (code >= 0xD800 && code < 0xDC00 && i + 2 < raw.size() &&
+                    raw[i + 1] == '\\' && raw[i + 2] == 'u') {
+                    long low = readHex4(raw, i + 3);
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                appendUtf8(out, static_cast<unsigned long>(code));
+                break;
+            }
+            default:
+                out += escape; // \" \\ \/
+                break;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A single-pass JSON reader that walks a buffer in place. The caller pulls
+// values in document order and gets strings back as views into the
+// buffer, so reading allocates nothing. Values the caller doesn't want
+// (including nested arrays and objects) are skipped with skipValue.
+//
+//   JsonReader reader(text);
+//   std::string_view key;
+//   reader.beginObject();
+//   while (reader.nextKey(key)) {
+//       if (key == "score") reader.readInt(score);
+//       else reader.skipValue();
+//   }
+//   reader.finish();
+//   if (reader.hasError()) ... reader.getError(), reader.getErrorOffset()
+//
+// The first error stops the reader: every later call fails, and the error
+// keeps the byte offset where the text went wrong.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text);
+
+    // True if only whitespace is left
+    bool atEnd();
+
+    // Containers. nextKey / nextElement move to the next member and return
+    // false when the container closes (or on an error).
+    bool beginObject();
+    bool nextKey(std::string_view& key);
+    bool beginArray();
+    bool nextElement();
+
+    // Values. Strings are returned raw, still escaped (see decode).
+    bool readString(std::string_view& value);
+    bool readInt(int& value);
+    bool skipValue();
+
+    // Check that nothing but whitespace follows the document
+    bool finish();
+
+    bool hasError() const { return error != nullptr; }
+    const char* getError() const { return error; }
+    size_t getErrorOffset() const { return errorOffset; }
+
+    // Turn a raw string from readString into its text (UTF-8)
+    static void decode(std::string_view raw, std::string& out);
+
+private:
+    // Record an error at the current position; always returns false
+    bool fail(const char* message);
+
+    void skipWhitespace();
+
+    // Expect a byte, after any whitespace
+    bool expect(char c, const char* message);
+
+    // Move to the next member of an array or object closed by 'close'
+    bool nextMember(char close);
+
+    bool skipNumber();
+    bool skipLiteral(std::string_view literal);
+
+    std::string_view text;
+    size_t pos;
+    bool afterValue; // A value ended; a comma or a close must come next
+    int depth;       // Containers skipValue is inside
+
+    const char* error;
+    size_t errorOffset;
+};
+
+#endif // JSONREADER_H
@@ -0,0 +1,285 @@
+#include "Leaderboard.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Copy text into a zero padded field, cut to fit
+template <size_t Size>
+void copyField(char (&field)[Size], std::string_view text) {
+    std::memset(field, 0, Size);
+    std::memcpy(field, text.data(), std::min(text.size(), Size - 1));
+}
+
+bool keyLess(const LeaderboardEntry& a, const LeaderboardEntry& b) {
+    return a.key < b.key;
+}
+
+} // namespace
+
+int LeaderboardEntry::getScore() const {
+    uint32_t flipped = static_cast<uint32_t>(key >> 32);
+    return static_cast<int>(~flipped ^ 0x80000000u);
+}
+
+std::string_view LeaderboardEntry::getInitials() const {
+    return std::string_view(initials, strnlen(initials, sizeof(initials)));
+}
+
+std::string_view LeaderboardEntry::getDate() const {
+    return std::string_view(date, strnlen(date, sizeof(date)));
+}
+
+Leaderboard::Leaderboard() {
+    clear();
+}
+
+LeaderboardEntry Leaderboard::makeEntry(int score, std::string_view initials,
+                                        std::string_view date) {
+    LeaderboardEntry entry;
+    entry.key = keyOf(score);
+    copyField(entry.initials, initials);
+    copyField(entry.date, date);
+    return entry;
+}
+
+void Leaderboard::clear() {
+    leaves.clear();
+    inners.clear();
+    leaves.push_back(Leaf());
+    leaves[0].count = 0;
+    leaves[0].next = NO_NODE;
+    root = 0;
+    height = 0;
+    total = 0;
+    nextOrder = 0;
+}
+
+uint64_t Leaderboard::keyOf(int score) {
+    // Scores sort highest first: flip the sign bit so the order matches
+    // unsigned order, then invert it
+    uint32_t flipped = ~(static_cast<uint32_t>(score) ^ 0x80000000u);
+    return static_cast<uint64_t>(flipped) << 32;
+}
+
+size_t Leaderboard::insert(LeaderboardEntry entry) {
+    entry.key = (entry.key & ~uint64_t(UINT32_MAX)) | nextOrder;
+    return insertKeyed(entry);
+}
+
+size_t Leaderboard::insertKeyed(const LeaderboardEntry& entry) {
+    nextOrder = std::max(nextOrder, orderOf(entry) + 1);
+
+    size_t position = 0;
+    Split split;
+    if (insertInto(root, height, entry, position, split)) {
+        // The root split: grow a level
+        Inner top;
+        top.count = 2;
+        top.keys[0] = 0;
+        top.keys[1] = split.key;
+        top.children[0] = root;
+        top.children[1] = split.node;
+        top.sizes[0] = static_cast<uint32_t>(subtreeSize(root, height));
+        top.sizes[1] = static_cast<uint32_t>(subtreeSize(split.node, height));
+        inners.push_back(top);
+        root = static_cast<uint32_t>(inners.size() - 1);
+        ++height;
+    }
+
+    ++total;
+    return position;
+}
+
+bool Leaderboard::insertInto(uint32_t node, int level, const LeaderboardEntry& entry,
+                             size_t& position, Split& split) {
+    if (level == 0) {
+        Leaf& leaf = leaves[node];
+        LeaderboardEntry* end = leaf.entries + leaf.count;
+        LeaderboardEntry* at = std::lower_bound(leaf.entries, end, entry, keyLess);
+        position += at - leaf.entries;
+        std::copy_backward(at, end, end + 1);
+        *at = entry;
+        if (++leaf.count <= LEAF_CAPACITY) return false;
+
+        // Move the upper half to a new leaf after this one
+        const uint32_t half = leaf.count / 2;
+        Leaf upper;
+        upper.count = leaf.count - half;
+        upper.next = leaf.next;
+        std::copy(leaf.entries + half, leaf.entries + leaf.count, upper.entries);
+        leaf.count = half;
+        leaf.next = static_cast<uint32_t>(leaves.size());
+
+        split.key = upper.entries[0].key;
+        split.node = leaf.next;
+        leaves.push_back(upper); // Invalidates leaf
+        return true;
+    }
+
+    int child = childFor(inners[node], entry.key);
+    for (int i = 0; i < child; ++i) {
+        position += inners[node].sizes[i];
+    }
+    ++inners[node].sizes[child];
+
+    Split below;
+    if (!insertInto(inners[node].children[child], level - 1, entry, position, below)) {
+        return false;
+    }
+
+    // Add the child's new sibling after it (re-fetched: the call may have
+    // added inner nodes)
+    Inner& inner = inners[node];
+    const int count = static_cast<int>(inner.count);
+    std::copy_backward(inner.keys + child + 1, inner.keys + count, inner.keys + count + 1);
+    std::copy_backward(inner.children + child + 1, inner.children + count,
+                       inner.children + count + 1);
+    std::copy_backward(inner.sizes + child + 1, inner.sizes + count, inner.sizes + count + 1);
+    inner.keys[child + 1] = below.key;
+    inner.children[child + 1] = below.node;
+    inner.sizes[child] = static_cast<uint32_t>(subtreeSize(inner.children[child], level - 1));
+    inner.sizes[child + 1] = static_cast<uint32_t>(subtreeSize(below.node, level - 1));
+    if (++inner.count <= FANOUT) return false;
+
+    // Move the upper half of the children to a new node
+    const uint32_t half = inner.count / 2;
+    Inner upper;
+    upper.count = inner.count - half;
+    std::copy(inner.keys + half, inner.keys + inner.count, upper.keys);
+    std::copy(inner.children + half, inner.children + inner.count, upper.children);
+    std::copy(inner.sizes + half, inner.sizes + inner.count, upper.sizes);
+    inner.count = half;
+
+    split.key = upper.keys[0];
+    split.node = static_cast<uint32_t>(inners.size());
+    inners.push_back(upper); // Invalidates inner
+    return true;
+}
+
+int Leaderboard::childFor(const Inner& node, uint64_t key) {
+    // Last child whose first key is not after the key
+    const uint64_t* first = node.keys + 1;
+    const uint64_t* last = node.keys + node.count;
+    return static_cast<int>(std::upper_bound(first, last, key) - first);
+}
+
+size_t Leaderboard::subtreeSize(uint32_t node, int level) const {
+    if (level == 0) return leaves[node].count;
+
+    const Inner& inner = inners[node];
+    size_t size = 0;
+    for (uint32_t i = 0; i < inner.count; ++i) {
+        size += inner.sizes[i];
+    }
+    return size;
+}
+
+void Leaderboard::build(std::vector<LeaderboardEntry> entries) {
+    uint32_t order = 0;
+    for (LeaderboardEntry& entry : entries) {
+        entry.key = (entry.key & ~uint64_t(UINT32_MAX)) | order++;
+    }
+    buildKeyed(std::move(entries));
+}
+
+void Leaderboard::buildKeyed(std::vector<LeaderboardEntry> entries) {
+    clear();
+    std::sort(entries.begin(), entries.end(), keyLess);
+    for (const LeaderboardEntry& entry : entries) {
+        nextOrder = std::max(nextOrder, orderOf(entry) + 1);
+    }
+
+    // Fill the leaves, then stack inner levels on them until one node is left
+    std::vector<uint32_t> level;
+    std::vector<uint64_t> firstKeys;
+    std::vector<uint32_t> sizes;
+    leaves.clear();
+    for (size_t start = 0; start < entries.size() || leaves.empty(); start += LEAF_CAPACITY) {
+        const size_t count = std::min<size_t>(LEAF_CAPACITY, entries.size() - start);
+        Leaf leaf;
+        leaf.count = static_cast<uint32_t>(count);
+        leaf.next = NO_NODE;
+        std::copy(entries.begin() + start, entries.begin() + start + count, leaf.entries);
+        if (!leaves.empty()) leaves.back().next = static_cast<uint32_t>(leaves.size());
+
+        level.push_back(static_cast<uint32_t>(leaves.size()));
+        firstKeys.push_back(count ? leaf.entries[0].key : 0);
+        sizes.push_back(leaf.count);
+        leaves.push_back(leaf);
+    }
+
+    while (level.size() > 1) {
+        std::vector<uint32_t> parents;
+        std::vector<uint64_t> parentKeys;
+        std::vector<uint32_t> parentSizes;
+        for (size_t start = 0; start < level.size(); start += FANOUT) {
+            const size_t count = std::min<size_t>(FANOUT, level.size() - start);
+            Inner inner;
+            inner.count = static_cast<uint32_t>(count);
+            uint32_t size = 0;
+            for (size_t i = 0; i < count; ++i) {
+                inner.keys[i] = firstKeys[start + i];
+                inner.children[i] = level[start + i];
+                inner.sizes[i] = sizes[start + i];
+                size += sizes[start + i];
+            }
+
+            parents.push_back(static_cast<uint32_t>(inners.size()));
+            parentKeys.push_back(inner.keys[0]);
+            parentSizes.push_back(size);
+            inners.push_back(inner);
+        }
+        level.swap(parents);
+        firstKeys.swap(parentKeys);
+        sizes.swap(parentSizes);
+        ++height;
+    }
+
+    root = level[0];
+    total = entries.size();
+}
+
+size_t Leaderboard::countBefore(uint64_t key) const {
+    size_t count = 0;
+
+    uint32_t node = root;
+    for (int level = height; level > 0; --level) {
+        const Inner& inner = inners[node];
+        const int child = childFor(inner, key);
+        for (int i = 0; i < child; ++i) {
+            count += inner.sizes[i];
+        }
+        node = inner.children[child];
+    }
+
+    const Leaf& leaf = leaves[node];
+    LeaderboardEntry probe;
+    probe.key = key;
+    return count + (std::lower_bound(leaf.entries, leaf.entries + leaf.count, probe, keyLess) -
+                    leaf.entries);
+}
+
+bool Leaderboard::locate(size_t position, uint32_t& leaf, uint32_t& index) const {
+    if (position >= total) return false;
+
+    uint32_t node = root;
+    for (int level = height; level > 0; --level) {
+        const Inner& inner = inners[node];
+        uint32_t child = 0;
+        while (position >= inner.sizes[child]) {
+            position -= inner.sizes[child];
+            ++child;
+        }
+        node = inner.children[child];
+    }
+
+    leaf = node;
+    index = static_cast<uint32_t>(position);
+    return true;
+}
+
+void Leaderboard::page(size_t position, size_t count, std::vector<LeaderboardEntry>& out) const {
+    out.clear();
+    forEach(position, count, [&out](const LeaderboardEntry& entry) { out.push_back(entry); });
+}
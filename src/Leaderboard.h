@@ -0,0 +1,137 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// One score on the leaderboard, in a fixed 24 bytes
+struct LeaderboardEntry {
+    uint64_t key;     // Sort key: score (highest first), then order added
+    char initials[4]; // Zero padded
+    char date[12];    // YYYY-MM-DD, zero padded
+
+    int getScore() const;
+    std::string_view getInitials() const;
+    std::string_view getDate() const;
+};
+
+// Every score ever played, kept in rank order. Adding a score, finding the
+// rank of a score, and reading a page of the table from any position all
+// take O(log n), so the table can grow to millions of entries.
+//
+// It is a B+tree whose inner nodes count the entries below each child:
+// ranks are sums of counts on the way down, and a page is found by
+// walking down by counts and then along the linked leaves. Equal scores
+// rank in the order they were added.
+class Leaderboard {
+public:
+    Leaderboard();
+
+    // Make an entry to add; initials and date are cut to fit
+    static LeaderboardEntry makeEntry(int score, std::string_view initials,
+                                      std::string_view date);
+
+    // Lowest key a score can have: every entry with the score sorts at or
+    // after it, every better score before it
+    static uint64_t keyOf(int score);
+
+    // Order an entry was added in (the low half of its key)
+    static uint32_t orderOf(const LeaderboardEntry& entry) {
+        return static_cast<uint32_t>(entry.key);
+    }
+
+    // Add an entry; returns its position (0 = top)
+    size_t insert(LeaderboardEntry entry);
+
+    // Add an entry whose key already holds its order (e.g. one read back
+    // from a file); later inserts are ordered after it
+    size_t insertKeyed(const LeaderboardEntry& entry);
+
+    // Replace the table with these entries, in any order (ties keep their
+    // order). Faster than inserting one by one.
+    void build(std::vector<LeaderboardEntry> entries);
+
+    // Same, for entries whose keys already hold their order
+    void buildKeyed(std::vector<LeaderboardEntry> entries);
+
+    void clear();
+
+    size_t size() const { return total; }
+
+    // Entries with a higher score; the rank of a score is this plus one
+    size_t countAbove(int score) const { return countBefore(keyOf(score)); }
+
+    // Entries that sort before a key
+    size_t countBefore(uint64_t key) const;
+
+    // Call fn(entry) for up to count entries from a position, in order
+    template <typename Fn>
+    void forEach(size_t position, size_t count, Fn fn) const {
+        uint32_t leaf;
+        uint32_t index;
+        if (!locate(position, leaf, index)) return;
+
+        while (count > 0 && leaf != NO_NODE) {
+            const Leaf& node = leaves[leaf];
+            for (; index < node.count && count > 0; ++index, --count) {
+                fn(node.entries[index]);
+            }
+            leaf = node.next;
+            index = 0;
+        }
+    }
+
+    // Copy up to count entries from a position into out (replacing it)
+    void page(size_t position, size_t count, std::vector<LeaderboardEntry>& out) const;
+
+private:
+    static constexpr int LEAF_CAPACITY = 64;
+    static constexpr int FANOUT = 64;
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    // Nodes have one spare slot so an insert can overfill them before
+    // they split
+    struct Leaf {
+        uint32_t count;
+        uint32_t next; // Leaf after this one, in rank order
+        LeaderboardEntry entries[LEAF_CAPACITY + 1];
+    };
+
+    struct Inner {
+        uint32_t count;                 // Children
+        uint64_t keys[FANOUT + 1];      // First key under each child (keys[0] unused)
+        uint32_t children[FANOUT + 1];  // Leaves at height 1, else inner nodes
+        uint32_t sizes[FANOUT + 1];     // Entries under each child
+    };
+
+    // Node added by a split, and the first key under it
+    struct Split {
+        uint64_t key;
+        uint32_t node;
+    };
+
+    // Add to the subtree at node (height 0 = a leaf), counting the entries
+    // before it into position. True if the node split.
+    bool insertInto(uint32_t node, int level, const LeaderboardEntry& entry,
+                    size_t& position, Split& split);
+
+    // Child of an inner node whose subtree a key belongs in
+    static int childFor(const Inner& node, uint64_t key);
+
+    // Entries under a node
+    size_t subtreeSize(uint32_t node, int level) const;
+
+    // Leaf and index of a position; false past the end
+    bool locate(size_t position, uint32_t& leaf, uint32_t& index) const;
+
+    std::vector<Leaf> leaves;
+    std::vector<Inner> inners;
+    uint32_t root;
+    int height; // Inner levels above the leaves
+    size_t total;
+    uint32_t nextOrder;
+};
+
+#endif // LEADERBOARD_H
@@ -0,0 +1,57 @@
+#include "NullRenderBackend.h"
+
+namespace {
+
+// Size only; nothing is ever drawn into it
+struct NullTexture {
+    int width;
+    int height;
+};
+
+} // namespace
+
+NullRenderBackend::NullRenderBackend()
+    : target(nullptr)
+    , liveTextures(0) {
+}
+
+NullRenderBackend::~NullRenderBackend() {
+    shutdown();
+}
+
+bool NullRenderBackend::init(int width, int height) {
+    (void)width;
+    (void)height;
+    target = nullptr;
+    return true;
+}
+
+void NullRenderBackend::shutdown() {
+    target = nullptr;
+}
+
+RenderTexture* NullRenderBackend::createTexture(int width, int height, TextureAccess access) {
+    (void)access;
+    if (width <= 0 || height <= 0) return nullptr;
+
+    ++liveTextures;
+    return reinterpret_cast<RenderTexture*>(new NullTexture{width, height});
+}
+
+RenderTexture* NullRenderBackend::createTextureFromSurface(SDL_Surface* surface) {
+    if (!surface) return nullptr;
+    return createTexture(surface->w, surface->h, TextureAccess::STATIC);
+}
+
+void NullRenderBackend::destroyTexture(RenderTexture* texture) {
+    if (!texture) return;
+    if (texture == target) target = nullptr;
+
+    --liveTextures;
+    delete reinterpret_cast<NullTexture*>(texture);
+}
+
+bool NullRenderBackend::setRenderTarget(RenderTexture* texture) {
+    target = texture;
+    return true;
+}
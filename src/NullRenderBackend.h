@@ -0,0 +1,55 @@
+#ifndef NULLRENDERBACKEND_H
+#define NULLRENDERBACKEND_H
+
+#include "RenderBackend.h"
+
+// Accepts every call and draws nothing. Textures are real objects (so
+// caches and atlases behave as usual) but hold no pixels. Used to measure
+// game and renderer bookkeeping without any rasterization cost.
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend();
+    ~NullRenderBackend() override;
+
+    bool init(int width, int height) override;
+    void shutdown() override;
+    const char* getName() const override { return "null"; }
+
+    void clear(SDL_Color) override {}
+    void present() override {}
+    void setDrawBlendMode(SDL_BlendMode) override {}
+    void setClipRect(const SDL_Rect*) override {}
+
+    void fillRect(const SDL_Rect&, SDL_Color) override {}
+    void drawRect(const SDL_Rect&, SDL_Color) override {}
+    void drawLine(int, int, int, int, SDL_Color) override {}
+    bool drawGeometry(RenderTexture*, const SDL_Vertex*, int, const int*, int) override {
+        return true;
+    }
+    void copy(RenderTexture*, const SDL_Rect*, const SDL_Rect*) override {}
+
+    RenderTexture* createTexture(int width, int height, TextureAccess access) override;
+    RenderTexture* createTextureFromSurface(SDL_Surface* surface) override;
+    void destroyTexture(RenderTexture* texture) override;
+    bool updateTexture(RenderTexture*, const SDL_Rect*, const void*, int) override {
+        return true;
+    }
+    void setTextureBlendMode(RenderTexture*, SDL_BlendMode) override {}
+    void setTextureScaleMode(RenderTexture*, SDL_ScaleMode) override {}
+
+    bool supportsRenderTargets() const override { return true; }
+    bool setRenderTarget(RenderTexture* texture) override;
+    RenderTexture* getRenderTarget() const override { return target; }
+
+    // There are no pixels to read
+    bool readPixels(const SDL_Rect*, void*, int) override { return false; }
+
+    // Textures currently alive (for leak checks)
+    int getLiveTextures() const { return liveTextures; }
+
+private:
+    RenderTexture* target;
+    int liveTextures;
+};
+
+#endif // NULLRENDERBACKEND_H
@@ -0,0 +1,121 @@
+#include "Options.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+void printUsage() {
+    printf("Usage: snake [--render=full|incremental|framebuffer] [--backend=sdl|software]\n"
+           "             [--record=FILE] [--skin=NAME] [--board=WIDTHxHEIGHT] [--fullscreen]\n"
+           "             [--low-latency] [--audio-buffer=FRAMES]\n"
+           "             [--import-scores=FILE] [--export-scores=FILE]\n"
+           "\n"
+           "  --render=full         Redraw the whole board every frame (default)\n"
+           "  --render=incremental  Repaint only the cells that changed; faster on\n"
+           "                        low-power devices such as the Raspberry Pi\n"
+           "  --render=framebuffer  Draw the board as one pixel per cell, scaled up;\n"
+           "                        the cost does not grow with the snake\n"
+           "  --backend=sdl         Draw with SDL's renderer, on the GPU if possible (default)\n"
+           "  --backend=software    Draw on the CPU; for machines without a working GPU\n"
+           "  --record=FILE         Record the game; FILE ending in .y4m or .raw writes\n"
+           "                        video, .png or .bmp writes a numbered image sequence\n"
+           "  --skin=NAME           Draw the snake and food with the pictures in\n"
+           "                        assets/images/skins/NAME\n"
+           "  --board=WIDTHxHEIGHT  Board size in cells (default %dx%d); bigger boards\n"
+           "                        scroll with the snake, zoom with + and -\n"
+           "  --fullscreen          Start fullscreen (F11 switches while playing)\n"
+           "  --low-latency         Small audio buffer (%d frames) so sounds play sooner\n"
+           "  --audio-buffer=FRAMES Audio buffer size, a power of two from %d to %d\n"
+           "                        (default %d); latency and underruns are printed\n"
+           "                        on exit to help pick the smallest that plays cleanly\n"
+           "  --import-scores=FILE  Add the scores in a JSON file (like %s)\n"
+           "                        to the high score table, then quit\n"
+           "  --export-scores=FILE  Write every score to a JSON file, then quit\n",
+           Constants::GRID_WIDTH, Constants::GRID_HEIGHT,
+           Constants::LOW_LATENCY_AUDIO_BUFFER, Constants::MIN_AUDIO_BUFFER,
+           Constants::MAX_AUDIO_BUFFER, Constants::AUDIO_CHUNK_SIZE,
+           Constants::HIGHSCORE_PATH);
+}
+
+// Parse "WIDTHxHEIGHT" within the allowed board sizes
+bool parseBoardSize(const char* text, int& width, int& height) {
+    char* end = nullptr;
+    long w = strtol(text, &end, 10);
+    if (end == text || (*end != 'x' && *end != 'X')) return false;
+
+    const char* rest = end + 1;
+    long h = strtol(rest, &end, 10);
+    if (end == rest || *end != '\0') return false;
+
+    if (w < Constants::INITIAL_SNAKE_LENGTH + 2 || h < 3 ||
+        w > Constants::MAX_BOARD_SIZE || h > Constants::MAX_BOARD_SIZE) {
+        return false;
+    }
+
+    width = static_cast<int>(w);
+    height = static_cast<int>(h);
+    return true;
+}
+
+// Parse a power-of-two audio buffer size within the allowed range
+bool parseAudioBuffer(const char* text, int& frames) {
+    char* end = nullptr;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    if (value < Constants::MIN_AUDIO_BUFFER || value > Constants::MAX_AUDIO_BUFFER ||
+        (value & (value - 1)) != 0) {
+        return false;
+    }
+
+    frames = static_cast<int>(value);
+    return true;
+}
+
+} // namespace
+
+bool parseOptions(int argc, char* argv[], GameOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--render=full") == 0) {
+            options.boardRenderMode = BoardRenderMode::FULL;
+        } else if (strcmp(arg, "--render=incremental") == 0) {
+            options.boardRenderMode = BoardRenderMode::INCREMENTAL;
+        } else if (strcmp(arg, "--render=framebuffer") == 0) {
+            options.boardRenderMode = BoardRenderMode::CELL_FRAMEBUFFER;
+        } else if (strcmp(arg, "--backend=sdl") == 0) {
+            options.renderBackend = RenderBackendType::SDL;
+        } else if (strcmp(arg, "--backend=software") == 0) {
+            options.renderBackend = RenderBackendType::SOFTWARE;
+        } else if (strncmp(arg, "--record=", 9) == 0 && arg[9] != '\0') {
+            options.recordPath = arg + 9;
+        } else if (strncmp(arg, "--skin=", 7) == 0 && arg[7] != '\0') {
+            options.skinName = arg + 7;
+        } else if (strcmp(arg, "--fullscreen") == 0) {
+            options.fullscreen = true;
+        } else if (strcmp(arg, "--low-latency") == 0) {
+            options.audioBufferFrames = Constants::LOW_LATENCY_AUDIO_BUFFER;
+        } else if (strncmp(arg, "--import-scores=", 16) == 0 && arg[16] != '\0') {
+            options.importScoresPath = arg + 16;
+        } else if (strncmp(arg, "--export-scores=", 16) == 0 && arg[16] != '\0') {
+            options.exportScoresPath = arg + 16;
+        } else if (strncmp(arg, "--audio-buffer=", 15) == 0) {
+            if (!parseAudioBuffer(arg + 15, options.audioBufferFrames)) {
+                printf("Error: --audio-buffer needs a power of two from %d to %d\n",
+                       Constants::MIN_AUDIO_BUFFER, Constants::MAX_AUDIO_BUFFER);
+                return false;
+            }
+        } else if (strncmp(arg, "--board=", 8) == 0) {
+            if (!parseBoardSize(arg + 8, options.boardWidth, options.boardHeight)) {
+                printf("Error: --board needs WIDTHxHEIGHT between %dx3 and %dx%d\n",
+                       Constants::INITIAL_SNAKE_LENGTH + 2,
+                       Constants::MAX_BOARD_SIZE, Constants::MAX_BOARD_SIZE);
+                return false;
+            }
+        } else {
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <string>
+#include "Constants.h"
+#include "RenderBackend.h"
+
+// Settings chosen on the command line
+struct GameOptions {
+    BoardRenderMode boardRenderMode;
+    RenderBackendType renderBackend;
+    std::string recordPath; // Capture frames here when not empty
+    std::string skinName;   // Sprite skin to load, or empty for shapes
+    int boardWidth;         // Board size in cells
+    int boardHeight;
+    bool fullscreen;
+    int audioBufferFrames;  // Audio device buffer (smaller = less delay)
+    std::string importScoresPath; // Add the scores in this JSON file, then quit
+    std::string exportScoresPath; // Write every score to this JSON file, then quit
+
+    GameOptions()
+        : boardRenderMode(BoardRenderMode::FULL)
+        , renderBackend(RenderBackendType::SDL)
+        , boardWidth(Constants::GRID_WIDTH)
+        , boardHeight(Constants::GRID_HEIGHT)
+        , fullscreen(false)
+        , audioBufferFrames(Constants::AUDIO_CHUNK_SIZE) {}
+};
+
+// Parse command line arguments. Prints usage and returns false on an
+// unknown argument.
+bool parseOptions(int argc, char* argv[], GameOptions& options);
+
+#endif // OPTIONS_H
@@ -0,0 +1,104 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Whole-pool update. Every array is a separate restrict parameter so the
+// compiler knows they don't overlap and vectorizes the loop; n must be a
+// multiple of PARTICLE_BLOCK.
+void integrate(float* __restrict posX, float* __restrict posY,
+               float* __restrict velX, float* __restrict velY,
+               float* __restrict life, float* __restrict fade,
+               const float* __restrict invLifetime, int n, float dt, float drag) {
+    for (int i = 0; i < n; ++i) {
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        velX[i] *= drag;
+        velY[i] *= drag;
+        life[i] -= dt;
+        fade[i] = life[i] * invLifetime[i];
+    }
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(int capacity)
+    : capacity((std::max(0, capacity) + PARTICLE_BLOCK - 1) & ~(PARTICLE_BLOCK - 1))
+    , count(0)
+    , posX(this->capacity)
+    , posY(this->capacity)
+    , velX(this->capacity)
+    , velY(this->capacity)
+    , life(this->capacity)
+    , invLifetime(this->capacity)
+    , fade(this->capacity)
+    , size(this->capacity)
+    , color(this->capacity) {
+    std::random_device rd;
+    rng.seed(rd());
+}
+
+void ParticleSystem::emit(float x, float y, int amount, SDL_Color particleColor,
+                          float speed, float lifetime) {
+    amount = std::min(amount, capacity - count);
+    if (amount <= 0 || lifetime <= 0.0f) return;
+
+    // Vary each particle a little so a burst doesn't look like a ring
+    std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> speedDist(0.2f, 1.0f);
+    std::uniform_real_distribution<float> lifeDist(0.6f, 1.0f);
+    std::uniform_real_distribution<float> sizeDist(Constants::PARTICLE_MIN_SIZE,
+                                                   Constants::PARTICLE_MAX_SIZE);
+
+    for (int n = 0; n < amount; ++n) {
+        int i = count++;
+        float angle = angleDist(rng);
+        float velocity = speed * speedDist(rng);
+        float particleLife = lifetime * lifeDist(rng);
+
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = std::cos(angle) * velocity;
+        velY[i] = std::sin(angle) * velocity;
+        life[i] = particleLife;
+        invLifetime[i] = 1.0f / particleLife;
+        fade[i] = 1.0f;
+        size[i] = sizeDist(rng);
+        color[i] = particleColor;
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    // Run whole blocks: the slots past the last particle are idle (zero
+    // velocity), and a trip count the compiler knows is a multiple of the
+    // vector width needs no scalar remainder loop
+    const int padded = (count + PARTICLE_BLOCK - 1) & ~(PARTICLE_BLOCK - 1);
+    const float drag = std::max(0.0f, 1.0f - Constants::PARTICLE_DRAG * dt);
+    integrate(posX.data(), posY.data(), velX.data(), velY.data(), life.data(),
+              fade.data(), invLifetime.data(), padded, dt, drag);
+
+    // Fill each dead slot with the last live particle
+    int i = 0;
+    while (i < count) {
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+
+        int last = --count;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        life[i] = life[last];
+        invLifetime[i] = invLifetime[last];
+        fade[i] = fade[last];
+        size[i] = size[last];
+        color[i] = color[last];
+
+        // Idle slots stay still (and out of denormal range)
+        velX[last] = 0.0f;
+        velY[last] = 0.0f;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <random>
+#include <vector>
+#include "Constants.h"
+
+// Short-lived colored squares for effects such as eating and dying.
+//
+// Particles live in a fixed-capacity pool laid out as one array per field
+// (structure of arrays), allocated once: emitting and updating never
+// allocate, and the update loops are straight passes over contiguous
+// floats that the compiler can vectorize. Live particles are kept packed
+// at the front of the arrays by moving the last one into each dead slot.
+//
+// The capacity is rounded up to a whole number of PARTICLE_BLOCKs.
+//
+// Positions are in board cells (x, y of a cell's top-left corner), so the
+// effects scroll and zoom with the camera.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(int capacity = Constants::MAX_PARTICLES);
+
+    // Spray `amount` particles out of a point in every direction at up to
+    // `speed` cells per second. They fade out over `lifetime` seconds.
+    // Particles that do not fit in the pool are dropped.
+    void emit(float x, float y, int amount, SDL_Color particleColor,
+              float speed, float lifetime);
+
+    // Move and age every particle by dt seconds, removing the dead ones
+    void update(float dt);
+
+    // Remove every particle
+    void clear() { count = 0; }
+
+    int getCount() const { return count; }
+    int getCapacity() const { return capacity; }
+
+    // Live particles are indices 0 .. getCount() - 1 of each array
+    const float* getX() const { return posX.data(); }
+    const float* getY() const { return posY.data(); }
+    const float* getSize() const { return size.data(); }       // Cells per side
+    const float* getFade() const { return fade.data(); }       // 1 when new, 0 when dead
+    const SDL_Color* getColor() const { return color.data(); }
+
+private:
+    static constexpr int PARTICLE_BLOCK = 8; // Floats per widest vector (AVX)
+
+    int capacity;
+    int count;
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> life;        // Seconds left
+    std::vector<float> invLifetime; // 1 / starting life
+    std::vector<float> fade;        // life * invLifetime, for drawing
+    std::vector<float> size;
+    std::vector<SDL_Color> color;
+
+    std::mt19937 rng;
+};
+
+#endif // PARTICLESYSTEM_H
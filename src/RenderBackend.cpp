@@ -0,0 +1,16 @@
+#include "RenderBackend.h"
+#include "NullRenderBackend.h"
+#include "SDLRenderBackend.h"
+#include "SoftwareRenderBackend.h"
+
+std::unique_ptr<RenderBackend> createRenderBackend(RenderBackendType type, bool windowed) {
+    switch (type) {
+        case RenderBackendType::SOFTWARE:
+            return std::make_unique<SoftwareRenderBackend>(windowed);
+        case RenderBackendType::NONE:
+            return std::make_unique<NullRenderBackend>();
+        case RenderBackendType::SDL:
+        default:
+            return std::make_unique<SDLRenderBackend>();
+    }
+}
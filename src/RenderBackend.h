@@ -0,0 +1,108 @@
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+
+// A texture created by a backend. The type is never defined: each backend
+// casts it to its own texture type, and textures must only be passed back
+// to the backend that created them.
+struct RenderTexture;
+
+// Available backend implementations
+enum class RenderBackendType {
+    SDL,      // SDL_Renderer in a window (GPU accelerated when available)
+    SOFTWARE, // CPU rasterizer into a memory framebuffer
+    NONE      // Accepts and discards everything (simulation throughput)
+};
+
+// How a texture will be used
+enum class TextureAccess {
+    STATIC,    // Uploaded once
+    STREAMING, // Updated often with updateTexture
+    TARGET     // Drawn into with setRenderTarget
+};
+
+// The drawing operations Renderer needs, so the same draw* code can run on
+// a GPU, on the CPU without a display, or not at all. Colors and textures
+// are straight (not premultiplied) ARGB8888, blend modes and vertices use
+// the SDL definitions.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Create the output (a window for SDL, a framebuffer otherwise)
+    virtual bool init(int width, int height) = 0;
+    virtual void shutdown() = 0;
+
+    // Short name for logs and benchmark output
+    virtual const char* getName() const = 0;
+
+    // Window for event handling, or nullptr when there is none
+    virtual SDL_Window* getWindow() const { return nullptr; }
+
+    // The output is always addressed in logical coordinates (the size
+    // passed to init). A bigger or high-DPI window shows it enlarged by a
+    // whole number of pixels per logical pixel, letterboxed; this is that
+    // number. 1 for backends that never scale.
+    virtual int getPixelScale() const { return 1; }
+
+    // Recompute the pixel scale after the window changed size or moved to
+    // another display. Returns true if it changed.
+    virtual bool updatePixelScale() { return false; }
+
+    // Multiply coordinates drawn into the current texture target by a
+    // whole factor, so a texture created at that many times its logical
+    // size is filled at full resolution. Selecting a target resets it to 1.
+    // Backends with a pixel scale of 1 never see anything else.
+    virtual void setTargetScale(int) {}
+
+    // Fill the current target with a color, ignoring the blend mode
+    virtual void clear(SDL_Color color) = 0;
+
+    // Show the finished frame
+    virtual void present() = 0;
+
+    // Blend mode for fillRect, drawLine and untextured geometry
+    virtual void setDrawBlendMode(SDL_BlendMode mode) = 0;
+
+    // Limit drawing (not clear) to a rectangle; nullptr draws everywhere
+    virtual void setClipRect(const SDL_Rect* rect) = 0;
+
+    // Primitives
+    virtual void fillRect(const SDL_Rect& rect, SDL_Color color) = 0;
+    virtual void drawRect(const SDL_Rect& rect, SDL_Color color) = 0; // 1 pixel outline
+    virtual void drawLine(int x1, int y1, int x2, int y2, SDL_Color color) = 0;
+    virtual bool drawGeometry(RenderTexture* texture,
+                              const SDL_Vertex* vertices, int numVertices,
+                              const int* indices, int numIndices) = 0;
+
+    // Draw a texture (or part of it) stretched into dest; nullptr means
+    // the whole texture or the whole target
+    virtual void copy(RenderTexture* texture, const SDL_Rect* src, const SDL_Rect* dest) = 0;
+
+    // Textures (ARGB8888). Returns nullptr on failure.
+    virtual RenderTexture* createTexture(int width, int height, TextureAccess access) = 0;
+    virtual RenderTexture* createTextureFromSurface(SDL_Surface* surface) = 0;
+    virtual void destroyTexture(RenderTexture* texture) = 0;
+    virtual bool updateTexture(RenderTexture* texture, const SDL_Rect* rect,
+                               const void* pixels, int pitch) = 0;
+    virtual void setTextureBlendMode(RenderTexture* texture, SDL_BlendMode mode) = 0;
+    virtual void setTextureScaleMode(RenderTexture* texture, SDL_ScaleMode mode) = 0;
+
+    // Render targets; nullptr selects the output again
+    virtual bool supportsRenderTargets() const = 0;
+    virtual bool setRenderTarget(RenderTexture* texture) = 0;
+    virtual RenderTexture* getRenderTarget() const = 0;
+
+    // Copy pixels of the current target as ARGB8888 (rect nullptr = all).
+    // The output is read at its logical size whatever the pixel scale.
+    virtual bool readPixels(const SDL_Rect* rect, void* pixels, int pitch) = 0;
+};
+
+// Create an uninitialized backend of the given type. A windowed software
+// backend shows its frames in a window without using the GPU; the SDL
+// backend always opens a window.
+std::unique_ptr<RenderBackend> createRenderBackend(RenderBackendType type, bool windowed);
+
+#endif // RENDERBACKEND_H
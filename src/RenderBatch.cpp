@@ -0,0 +1,71 @@
+#include "RenderBatch.h"
+
+RenderBatch::RenderBatch() {
+    // 1024 quads: a typical frame's snake and food. Bigger frames grow the
+    // buffers once, and clear() keeps what they grew to.
+    vertices.reserve(4096);
+    indices.reserve(6144);
+}
+
+void RenderBatch::clear() {
+    vertices.clear();
+    indices.clear();
+}
+
+void RenderBatch::addQuadIndices(int base) {
+    indices.push_back(base);
+    indices.push_back(base + 1);
+    indices.push_back(base + 2);
+    indices.push_back(base);
+    indices.push_back(base + 2);
+    indices.push_back(base + 3);
+}
+
+void RenderBatch::addRect(float x, float y, float w, float h, SDL_Color color) {
+    int base = static_cast<int>(vertices.size());
+
+    vertices.push_back({{x, y}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x + w, y}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x + w, y + h}, color, {0.0f, 0.0f}});
+    vertices.push_back({{x, y + h}, color, {0.0f, 0.0f}});
+
+    addQuadIndices(base);
+}
+
+void RenderBatch::addOutlinedRect(float x, float y, float w, float h,
+                                  SDL_Color fillColor, SDL_Color outlineColor) {
+    addRect(x, y, w, h, outlineColor);
+    addRect(x + 2, y + 2, w - 4, h - 4, fillColor);
+}
+
+void RenderBatch::addTexturedRect(const SDL_FRect& dest, const SDL_FRect& uv, SDL_Color color,
+                                  int quarterTurns) {
+    int base = static_cast<int>(vertices.size());
+
+    // Texture corners clockwise from top-left; turning the image moves
+    // each one to the next corner of the quad
+    const SDL_FPoint corners[4] = {
+        {uv.x, uv.y},
+        {uv.x + uv.w, uv.y},
+        {uv.x + uv.w, uv.y + uv.h},
+        {uv.x, uv.y + uv.h}
+    };
+    int turn = ((quarterTurns % 4) + 4) % 4;
+
+    vertices.push_back({{dest.x, dest.y}, color, corners[(4 - turn) % 4]});
+    vertices.push_back({{dest.x + dest.w, dest.y}, color, corners[(5 - turn) % 4]});
+    vertices.push_back({{dest.x + dest.w, dest.y + dest.h}, color, corners[(6 - turn) % 4]});
+    vertices.push_back({{dest.x, dest.y + dest.h}, color, corners[(7 - turn) % 4]});
+
+    addQuadIndices(base);
+}
+
+bool RenderBatch::flush(RenderBackend& backend, RenderTexture* texture) {
+    if (vertices.empty()) return false;
+
+    bool drawn = backend.drawGeometry(texture,
+                                      vertices.data(), static_cast<int>(vertices.size()),
+                                      indices.data(), static_cast<int>(indices.size()));
+    clear();
+    return drawn;
+}
@@ -0,0 +1,49 @@
+#ifndef RENDERBATCH_H
+#define RENDERBATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "RenderBackend.h"
+
+// Collects quads into one vertex/index list so they can be submitted with a
+// single drawGeometry call. The buffers are kept between flushes, so
+// after the first few frames batching does not allocate.
+class RenderBatch {
+public:
+    RenderBatch();
+    ~RenderBatch() = default;
+
+    // Discard queued quads
+    void clear();
+
+    // Number of queued quads
+    int getQuadCount() const { return static_cast<int>(vertices.size() / 4); }
+    bool isEmpty() const { return vertices.empty(); }
+
+    // Queue a solid colored quad
+    void addRect(float x, float y, float w, float h, SDL_Color color);
+
+    // Queue a quad with a 2 pixel border: the outline color fills the whole
+    // rectangle and the fill color is drawn inset on top of it
+    void addOutlinedRect(float x, float y, float w, float h,
+                         SDL_Color fillColor, SDL_Color outlineColor);
+
+    // Queue a textured quad; uv is in normalized texture coordinates and the
+    // texel color is multiplied by color. The image is turned clockwise by
+    // quarterTurns * 90 degrees.
+    void addTexturedRect(const SDL_FRect& dest, const SDL_FRect& uv, SDL_Color color,
+                         int quarterTurns = 0);
+
+    // Submit all queued quads in one draw call and clear the batch.
+    // Returns true if a draw call was issued.
+    bool flush(RenderBackend& backend, RenderTexture* texture = nullptr);
+
+private:
+    // Append the two triangles of the quad whose first vertex is at base
+    void addQuadIndices(int base);
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+#endif // RENDERBATCH_H
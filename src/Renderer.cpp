@@ -1,14 +1,65 @@
 #include "Renderer.h"
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
+#include "AssetPack.h"
+
+namespace {
+
+// The game's own font, from the asset pack when it has one
+TTF_Font* openGameFont(int pointSize) {
+    SDL_RWops* rw = openAsset(Constants::FONT_PATH);
+    return rw ? TTF_OpenFontRW(rw, 1, pointSize) : nullptr;
+}
+
+// Clockwise quarter turns from facing up
+int quarterTurns(Direction dir) {
+    switch (dir) {
+        case Direction::RIGHT: return 1;
+        case Direction::DOWN: return 2;
+        case Direction::LEFT: return 3;
+        default: return 0;
+    }
+}
+
+// Direction from a cell to a neighbouring one
+Direction directionTo(const Position& from, const Position& to) {
+    if (to.y < from.y) return Direction::UP;
+    if (to.y > from.y) return Direction::DOWN;
+    if (to.x < from.x) return Direction::LEFT;
+    if (to.x > from.x) return Direction::RIGHT;
+    return Direction::NONE;
+}
+
+// A count with thousands separators, e.g. 2,100,000
+std::string groupDigits(size_t value) {
+    std::string digits = std::to_string(value);
+    for (int i = static_cast<int>(digits.size()) - 3; i > 0; i -= 3) {
+        digits.insert(static_cast<size_t>(i), 1, ',');
+    }
+    return digits;
+}
+
+} // namespace
 
 Renderer::Renderer()
-    : window(nullptr)
-    , renderer(nullptr)
+    : backend()
+    , outputWidth(0)
+    , outputHeight(0)
+    , pixelScale(1)
     , fontSmall(nullptr)
     , fontMedium(nullptr)
     , fontLarge(nullptr)
     , fontTitle(nullptr)
+    , backgroundLayer(nullptr)
+    , scanlineLayer(nullptr)
+    , scanlinesEnabled(false)
+    , boardRenderMode(BoardRenderMode::FULL)
+    , boardLayer(nullptr)
+    , boardTracker(Constants::GRID_WIDTH, Constants::GRID_HEIGHT)
+    , cellFramebuffer(Constants::GRID_WIDTH, Constants::GRID_HEIGHT)
+    , followedGeneration(0)
+    , boardLayerStale(false)
     , initialized(false)
     , frameCount(0) {
 }
@@ -17,54 +68,131 @@ Renderer::~Renderer() {
     shutdown();
 }
 
-bool Renderer::init() {
-    // Initialize SDL video
-    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
-        printf("Error: Could not initialize SDL video: %s\n", SDL_GetError());
+bool Renderer::init(RenderBackendType type) {
+    return initBackend(createRenderBackend(type, true),
+                       Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT);
+}
+
+bool Renderer::initHeadless(int width, int height, RenderBackendType type) {
+    return initBackend(createRenderBackend(type, false), width, height);
+}
+
+bool Renderer::initBackend(std::unique_ptr<RenderBackend> newBackend, int width, int height) {
+    if (!startBackend(std::move(newBackend), width, height)) {
+        return false;
+    }
+
+    if (!loadFonts()) {
+        return false;
+    }
+
+    buildStaticLayers();
+
+    initialized = true;
+    return true;
+}
+
+bool Renderer::initWindow(RenderBackendType type, StartupTimeline& timeline) {
+    if (!startBackend(createRenderBackend(type, true),
+                      Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT)) {
         return false;
     }
 
+    // The layers need no fonts: build them now so the first frame is ready
+    buildStaticLayers();
+    initialized = true;
+
+    // Opening fonts reads them from disk and may probe several fallbacks
+    const int scale = pixelScale;
+    fontLoad = std::async(std::launch::async, [scale, &timeline] {
+        return timeline.time("fonts", [scale] {
+            FontSet fonts;
+            openFontSet(scale, fonts);
+            return fonts;
+        });
+    });
+    return true;
+}
+
+bool Renderer::finishLoading() {
+    if (!fontLoad.valid()) return true;
+    if (!isLoadFinished(fontLoad)) return false;
+
+    FontSet fonts = fontLoad.get();
+    useFonts(fonts);
+    if (!hasFonts()) return true;
+
+    // The window may have changed scale while the fonts were loading
+    if (fonts.scale != pixelScale) {
+        rebuildScaledResources();
+    } else {
+        buildGlyphAtlases();
+    }
+    return true;
+}
+
+void Renderer::waitForFonts() {
+    if (fontLoad.valid()) {
+        useFonts(fontLoad.get());
+    }
+}
+
+bool Renderer::startBackend(std::unique_ptr<RenderBackend> newBackend, int width, int height) {
+    backend = std::move(newBackend);
+    if (!backend->init(width, height)) {
+        printf("Error: Could not initialize %s renderer\n", backend->getName());
+        return false;
+    }
+
+    outputWidth = width;
+    outputHeight = height;
+    pixelScale = std::min(backend->getPixelScale(), Constants::MAX_PIXEL_SCALE);
+    textCache.setBackend(backend.get());
+    textCache.setPixelScale(pixelScale);
+
     // Initialize SDL_ttf
     if (TTF_Init() < 0) {
         printf("Error: Could not initialize SDL_ttf: %s\n", TTF_GetError());
         return false;
     }
+    return true;
+}
 
-    // Create window
-    window = SDL_CreateWindow(
-        Constants::WINDOW_TITLE,
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        Constants::WINDOW_WIDTH,
-        Constants::WINDOW_HEIGHT,
-        SDL_WINDOW_SHOWN
-    );
-
-    if (!window) {
-        printf("Error: Could not create window: %s\n", SDL_GetError());
+bool Renderer::loadFonts() {
+    if (!openFonts()) {
         return false;
     }
 
-    // Create renderer with vsync
-    renderer = SDL_CreateRenderer(window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    buildGlyphAtlases();
+    return true;
+}
 
-    if (!renderer) {
-        printf("Error: Could not create renderer: %s\n", SDL_GetError());
+bool Renderer::openFonts() {
+    FontSet fonts;
+    if (!openFontSet(pixelScale, fonts)) {
         return false;
     }
+    useFonts(fonts);
+    return true;
+}
 
-    // Set blend mode for transparency
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+void Renderer::useFonts(const FontSet& fonts) {
+    fontSmall = fonts.fontSmall;
+    fontMedium = fonts.fontMedium;
+    fontLarge = fonts.fontLarge;
+    fontTitle = fonts.fontTitle;
+}
 
-    // Load fonts at different sizes
-    fontSmall = TTF_OpenFont(Constants::FONT_PATH, 16);
-    fontMedium = TTF_OpenFont(Constants::FONT_PATH, 24);
-    fontLarge = TTF_OpenFont(Constants::FONT_PATH, 32);
-    fontTitle = TTF_OpenFont(Constants::FONT_PATH, 64);
+bool Renderer::openFontSet(int scale, FontSet& fonts) {
+    // Load fonts at different sizes, rasterized at the pixel scale
+    fonts.scale = scale;
+    fonts.fontSmall = openGameFont(16 * scale);
+    fonts.fontMedium = openGameFont(24 * scale);
+    fonts.fontLarge = openGameFont(32 * scale);
+    fonts.fontTitle = openGameFont(64 * scale);
 
     // If custom font fails, try system fonts
-    if (!fontSmall || !fontMedium || !fontLarge || !fontTitle) {
+    if (!fonts.fontSmall || !fonts.fontMedium || !fonts.fontLarge || !fonts.fontTitle) {
         printf("Warning: Could not load pixel font, trying system fonts\n");
 
         // Try common system font paths
@@ -77,137 +205,376 @@ bool Renderer::init() {
         };
 
         for (int i = 0; fallbackFonts[i] != nullptr; ++i) {
-            if (!fontSmall) fontSmall = TTF_OpenFont(fallbackFonts[i], 16);
-            if (!fontMedium) fontMedium = TTF_OpenFont(fallbackFonts[i], 24);
-            if (!fontLarge) fontLarge = TTF_OpenFont(fallbackFonts[i], 32);
-            if (!fontTitle) fontTitle = TTF_OpenFont(fallbackFonts[i], 64);
+            if (!fonts.fontSmall) fonts.fontSmall = TTF_OpenFont(fallbackFonts[i], 16 * scale);
+            if (!fonts.fontMedium) fonts.fontMedium = TTF_OpenFont(fallbackFonts[i], 24 * scale);
+            if (!fonts.fontLarge) fonts.fontLarge = TTF_OpenFont(fallbackFonts[i], 32 * scale);
+            if (!fonts.fontTitle) fonts.fontTitle = TTF_OpenFont(fallbackFonts[i], 64 * scale);
 
-            if (fontSmall && fontMedium && fontLarge && fontTitle) break;
+            if (fonts.fontSmall && fonts.fontMedium && fonts.fontLarge && fonts.fontTitle) break;
         }
     }
 
-    if (!fontMedium) {
+    if (!fonts.fontMedium) {
         printf("Error: Could not load any font\n");
+        if (fonts.fontSmall) TTF_CloseFont(fonts.fontSmall);
+        if (fonts.fontLarge) TTF_CloseFont(fonts.fontLarge);
+        if (fonts.fontTitle) TTF_CloseFont(fonts.fontTitle);
+        fonts.fontSmall = fonts.fontLarge = fonts.fontTitle = nullptr;
         return false;
     }
 
     // Use available fonts as fallback
-    if (!fontSmall) fontSmall = fontMedium;
-    if (!fontLarge) fontLarge = fontMedium;
-    if (!fontTitle) fontTitle = fontLarge;
-
-    initialized = true;
+    if (!fonts.fontSmall) fonts.fontSmall = fonts.fontMedium;
+    if (!fonts.fontLarge) fonts.fontLarge = fonts.fontMedium;
+    if (!fonts.fontTitle) fonts.fontTitle = fonts.fontLarge;
     return true;
 }
 
-void Renderer::shutdown() {
+void Renderer::closeFonts() {
     if (fontTitle && fontTitle != fontLarge) TTF_CloseFont(fontTitle);
     if (fontLarge && fontLarge != fontMedium) TTF_CloseFont(fontLarge);
     if (fontMedium) TTF_CloseFont(fontMedium);
     if (fontSmall && fontSmall != fontMedium) TTF_CloseFont(fontSmall);
 
     fontTitle = fontLarge = fontMedium = fontSmall = nullptr;
+}
 
-    if (renderer) {
-        SDL_DestroyRenderer(renderer);
-        renderer = nullptr;
+void Renderer::buildGlyphAtlases() {
+    // A failed atlas is not fatal: drawText falls back to SDL_ttf per string
+    // for that size only, so every atlas is still tried
+    struct AtlasFont {
+        GlyphAtlas& atlas;
+        TTF_Font* font;
+        const char* name;
+    };
+    const AtlasFont atlases[] = {
+        {atlasSmall, fontSmall, "small"},
+        {atlasMedium, fontMedium, "medium"},
+        {atlasLarge, fontLarge, "large"},
+        {atlasTitle, fontTitle, "title"},
+    };
+    for (const AtlasFont& entry : atlases) {
+        if (!entry.atlas.build(*backend, entry.font, pixelScale)) {
+            printf("Warning: Glyph atlas for %s text unavailable, it will be rasterized per frame\n",
+                   entry.name);
+        }
     }
+}
 
-    if (window) {
-        SDL_DestroyWindow(window);
-        window = nullptr;
+void Renderer::shutdown() {
+    waitForFonts();
+    skinLoader.shutdown();
+    skin.destroy();
+    cellFramebuffer.destroy();
+    destroyBoardLayer();
+    destroyStaticLayers();
+    textCache.clear();
+    atlasSmall.destroy();
+    atlasMedium.destroy();
+    atlasLarge.destroy();
+    atlasTitle.destroy();
+    closeFonts();
+
+    if (backend) {
+        backend->shutdown();
+        backend.reset();
     }
+    textCache.setBackend(nullptr);
 
     TTF_Quit();
     initialized = false;
 }
 
+void Renderer::setFullscreen(bool fullscreen) {
+    SDL_Window* window = getWindow();
+    if (!window) return;
+
+    if (SDL_SetWindowFullscreen(window, fullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0) < 0) {
+        printf("Warning: Could not change fullscreen mode: %s\n", SDL_GetError());
+        return;
+    }
+    handleOutputResize();
+}
+
+bool Renderer::isFullscreen() const {
+    SDL_Window* window = getWindow();
+    return window && (SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN) != 0;
+}
+
+void Renderer::handleOutputResize() {
+    if (!backend || !backend->updatePixelScale()) return;
+
+    // Past the cap the backend enlarges our textures instead
+    int scale = std::min(backend->getPixelScale(), Constants::MAX_PIXEL_SCALE);
+    if (scale == pixelScale) return;
+
+    pixelScale = scale;
+    rebuildScaledResources();
+}
+
+void Renderer::handleRenderReset(bool deviceLost) {
+    if (!backend) return;
+
+    if (deviceLost) {
+        // Every texture is gone: recreate them all, the skin from disk
+        std::string skinName = skin.isReady() ? skin.getName() : std::string();
+        skin.destroy();
+        if (!skinName.empty()) skinLoader.load(skinName);
+        cellFramebuffer.destroy();
+        rebuildScaledResources();
+        return;
+    }
+
+    // Only render targets lost their pixels: draw them again
+    textCache.clear();
+    buildStaticLayers();
+    destroyBoardLayer();
+    boardTracker.invalidate();
+}
+
+void Renderer::rebuildScaledResources() {
+    textCache.clear();
+    textCache.setPixelScale(pixelScale);
+
+    // Fonts still loading are reopened by finishLoading if the scale changed
+    if (!fontLoad.valid()) {
+        closeFonts();
+        if (openFonts()) {
+            buildGlyphAtlases();
+        } else {
+            atlasSmall.destroy();
+            atlasMedium.destroy();
+            atlasLarge.destroy();
+            atlasTitle.destroy();
+        }
+    }
+
+    buildStaticLayers();
+
+    // The board layer is created again at the new size on the next frame
+    destroyBoardLayer();
+    boardTracker.invalidate();
+}
+
+void Renderer::setTarget(RenderTexture* texture) {
+    backend->setRenderTarget(texture);
+    if (texture) backend->setTargetScale(pixelScale);
+}
+
+RenderTexture* Renderer::createLayerTexture() {
+    return backend->createTexture(Constants::WINDOW_WIDTH * pixelScale,
+                                  Constants::WINDOW_HEIGHT * pixelScale,
+                                  TextureAccess::TARGET);
+}
+
 void Renderer::clear() {
-    SDL_SetRenderDrawColor(renderer,
+    applyLoadedSkin();
+
+    backend->clear(makeColor(
         Constants::Colors::BG_R,
         Constants::Colors::BG_G,
         Constants::Colors::BG_B,
-        Constants::Colors::BG_A);
-    SDL_RenderClear(renderer);
+        Constants::Colors::BG_A));
+    ++stats.drawCalls;
+    ++stats.frames;
     frameCount++;
 }
 
 void Renderer::present() {
     // Optional: Add scanline effect
-    // drawScanlines();
-    SDL_RenderPresent(renderer);
+    if (scanlinesEnabled) {
+        if (scanlineLayer) {
+            backend->copy(scanlineLayer, nullptr, nullptr);
+            ++stats.drawCalls;
+        } else {
+            drawScanlines();
+        }
+    }
+    backend->present();
+}
+
+bool Renderer::readPixels(void* pixels, int pitch) {
+    if (!backend) return false;
+
+    // Read the output, not whatever layer happens to be the target
+    RenderTexture* previousTarget = backend->getRenderTarget();
+    setTarget(nullptr);
+    bool ok = backend->readPixels(nullptr, pixels, pitch);
+    setTarget(previousTarget);
+    return ok;
+}
+
+void Renderer::buildStaticLayers() {
+    destroyStaticLayers();
+    if (!backend->supportsRenderTargets()) return;
+
+    RenderTexture* previousTarget = backend->getRenderTarget();
+    RenderStats savedStats = stats; // Building is not part of any frame
+
+    backgroundLayer = createLayerTexture();
+    if (backgroundLayer) {
+        setTarget(backgroundLayer);
+        backend->clear(makeColor(
+            Constants::Colors::BG_R,
+            Constants::Colors::BG_G,
+            Constants::Colors::BG_B,
+            Constants::Colors::BG_A));
+        drawGridLines();
+        drawHudDivider();
+        backend->setTextureBlendMode(backgroundLayer, SDL_BLENDMODE_NONE);
+    }
+
+    scanlineLayer = createLayerTexture();
+    if (scanlineLayer) {
+        setTarget(scanlineLayer);
+        backend->clear(makeColor(0, 0, 0, 0));
+
+        // Write the line alpha as-is instead of blending onto transparency
+        backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
+        drawScanlines();
+        backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
+        backend->setTextureBlendMode(scanlineLayer, SDL_BLENDMODE_BLEND);
+    }
+
+    setTarget(previousTarget);
+    stats = savedStats;
+}
+
+void Renderer::destroyStaticLayers() {
+    if (backgroundLayer) {
+        backend->destroyTexture(backgroundLayer);
+        backgroundLayer = nullptr;
+    }
+    if (scanlineLayer) {
+        backend->destroyTexture(scanlineLayer);
+        scanlineLayer = nullptr;
+    }
 }
 
 int Renderer::gridToScreenX(int gridX) const {
-    return gridX * Constants::CELL_SIZE;
+    return camera.cellToScreenX(gridX);
 }
 
 int Renderer::gridToScreenY(int gridY) const {
-    return gridY * Constants::CELL_SIZE + Constants::GRID_OFFSET_Y;
+    return camera.cellToScreenY(gridY);
 }
 
 SDL_Color Renderer::makeColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
     return {r, g, b, a};
 }
 
-void Renderer::drawText(const std::string& text, int x, int y, SDL_Color color,
-                        bool centered, int fontSize) {
-    if (text.empty()) return;
+TTF_Font* Renderer::fontForSize(int fontSize) const {
+    if (fontSize <= 16) return fontSmall;
+    if (fontSize >= 48) return fontTitle;
+    if (fontSize >= 32) return fontLarge;
+    return fontMedium;
+}
+
+const GlyphAtlas& Renderer::atlasForSize(int fontSize) const {
+    if (fontSize <= 16) return atlasSmall;
+    if (fontSize >= 48) return atlasTitle;
+    if (fontSize >= 32) return atlasLarge;
+    return atlasMedium;
+}
 
-    TTF_Font* font = fontMedium;
-    if (fontSize <= 16) font = fontSmall;
-    else if (fontSize >= 48) font = fontTitle;
-    else if (fontSize >= 32) font = fontLarge;
+RenderTexture* Renderer::renderTextTexture(const std::string& text, int fontSize,
+                                           SDL_Color color, int* width, int* height) {
+    const GlyphAtlas& atlas = atlasForSize(fontSize);
+
+    // Compose the string from the glyph atlas on the GPU when possible
+    if (atlas.isReady() && backend->supportsRenderTargets()) {
+        *width = atlas.measureText(text);
+        *height = atlas.getLineHeight();
+        if (*width <= 0 || *height <= 0) return nullptr;
+
+        RenderTexture* texture = backend->createTexture(*width * pixelScale, *height * pixelScale,
+                                                        TextureAccess::TARGET);
+        if (texture) {
+            RenderTexture* previousTarget = backend->getRenderTarget();
+            setTarget(texture);
+            backend->clear(makeColor(0, 0, 0, 0));
+
+            atlas.addText(textBatch, text, 0, 0, color);
+            textBatch.flush(*backend, atlas.getTexture());
+
+            setTarget(previousTarget);
+            backend->setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            return texture;
+        }
+    }
+
+    // Otherwise rasterize with SDL_ttf
+    SDL_Surface* surface = TTF_RenderText_Solid(fontForSize(fontSize), text.c_str(), color);
+    if (!surface) return nullptr;
+    ++stats.textRenders;
+
+    // The fonts are opened at the pixel scale
+    RenderTexture* texture = backend->createTextureFromSurface(surface);
+    *width = (surface->w + pixelScale - 1) / pixelScale;
+    *height = (surface->h + pixelScale - 1) / pixelScale;
+    SDL_FreeSurface(surface);
+    return texture;
+}
 
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!surface) return;
+void Renderer::drawText(const std::string& text, int x, int y, SDL_Color color,
+                        bool centered, int fontSize) {
+    if (text.empty() || !hasFonts()) return;
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    // Most strings are identical every frame: draw the retained texture
+    int width = 0;
+    int height = 0;
+    RenderTexture* texture = textCache.find(text, fontSize, color, &width, &height);
     if (!texture) {
-        SDL_FreeSurface(surface);
-        return;
+        texture = renderTextTexture(text, fontSize, color, &width, &height);
+        textCache.insert(text, fontSize, color, texture, width, height);
     }
 
-    SDL_Rect destRect;
-    destRect.w = surface->w;
-    destRect.h = surface->h;
-    destRect.x = centered ? (x - destRect.w / 2) : x;
-    destRect.y = y;
-
-    SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+    if (texture) {
+        SDL_Rect destRect = {centered ? (x - width / 2) : x, y, width, height};
+        backend->copy(texture, nullptr, &destRect);
+        ++stats.drawCalls;
+        return;
+    }
 
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+    // Could not create a texture: draw quads straight from the atlas
+    const GlyphAtlas& atlas = atlasForSize(fontSize);
+    if (atlas.isReady()) {
+        int drawX = centered ? (x - atlas.measureText(text) / 2) : x;
+        atlas.addText(textBatch, text, drawX, y, color);
+        if (textBatch.flush(*backend, atlas.getTexture())) {
+            ++stats.drawCalls;
+        }
+    }
 }
 
 void Renderer::drawRect(int x, int y, int w, int h, SDL_Color color, bool filled) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
     SDL_Rect rect = {x, y, w, h};
 
     if (filled) {
-        SDL_RenderFillRect(renderer, &rect);
+        backend->fillRect(rect, color);
     } else {
-        SDL_RenderDrawRect(renderer, &rect);
+        backend->drawRect(rect, color);
     }
+    ++stats.drawCalls;
 }
 
-void Renderer::drawRectWithOutline(int x, int y, int w, int h,
-                                   SDL_Color fillColor, SDL_Color outlineColor) {
-    // Draw fill
-    drawRect(x, y, w, h, fillColor, true);
-
-    // Draw outline (2 pixels thick)
-    SDL_SetRenderDrawColor(renderer, outlineColor.r, outlineColor.g,
-                           outlineColor.b, outlineColor.a);
+void Renderer::drawGrid() {
+    if (!camera.isIdentity()) {
+        drawCulledGrid();
+        return;
+    }
 
-    SDL_Rect outer = {x, y, w, h};
-    SDL_RenderDrawRect(renderer, &outer);
+    if (backgroundLayer) {
+        backend->copy(backgroundLayer, nullptr, nullptr);
+        ++stats.drawCalls;
+        return;
+    }
 
-    SDL_Rect inner = {x + 1, y + 1, w - 2, h - 2};
-    SDL_RenderDrawRect(renderer, &inner);
+    drawGridLines();
+    drawHudDivider();
 }
 
-void Renderer::drawGrid() {
+void Renderer::drawGridLines() {
     SDL_Color gridColor = makeColor(
         Constants::Colors::GRID_R,
         Constants::Colors::GRID_G,
@@ -215,21 +582,20 @@ void Renderer::drawGrid() {
         Constants::Colors::GRID_A
     );
 
-    SDL_SetRenderDrawColor(renderer, gridColor.r, gridColor.g,
-                           gridColor.b, gridColor.a);
-
-    // Draw vertical lines
+    // The default board, whatever the camera shows (these lines also
+    // build the background layer)
     for (int x = 0; x <= Constants::GRID_WIDTH; ++x) {
-        int screenX = gridToScreenX(x);
-        SDL_RenderDrawLine(renderer, screenX, Constants::GRID_OFFSET_Y,
-                           screenX, Constants::WINDOW_HEIGHT);
+        int screenX = x * Constants::CELL_SIZE;
+        backend->drawLine(screenX, Constants::GRID_OFFSET_Y,
+                          screenX, Constants::WINDOW_HEIGHT, gridColor);
+        ++stats.drawCalls;
     }
 
     // Draw horizontal lines
     for (int y = 0; y <= Constants::GRID_HEIGHT; ++y) {
-        int screenY = gridToScreenY(y);
-        SDL_RenderDrawLine(renderer, 0, screenY,
-                           Constants::WINDOW_WIDTH, screenY);
+        int screenY = y * Constants::CELL_SIZE + Constants::GRID_OFFSET_Y;
+        backend->drawLine(0, screenY, Constants::WINDOW_WIDTH, screenY, gridColor);
+        ++stats.drawCalls;
     }
 }
 
@@ -237,20 +603,27 @@ void Renderer::drawSnake(const Snake& snake) {
     const auto& segments = snake.getSegments();
     if (segments.empty()) return;
 
-    SDL_Color headColor = makeColor(
-        Constants::Colors::HEAD_R,
-        Constants::Colors::HEAD_G,
-        Constants::Colors::HEAD_B,
-        Constants::Colors::HEAD_A
-    );
+    if (skin.isReady()) {
+        queueSnakeSprites(snake);
+        if (shapeBatch.flush(*backend, skin.getTexture())) {
+            ++stats.drawCalls;
+        }
+        return;
+    }
 
-    SDL_Color bodyColor = makeColor(
-        Constants::Colors::BODY_R,
-        Constants::Colors::BODY_G,
-        Constants::Colors::BODY_B,
-        Constants::Colors::BODY_A
-    );
+    // Body back to front, then the head; the whole snake is submitted as
+    // one draw call at the end
+    const int length = static_cast<int>(segments.size());
+    for (int i = length - 1; i >= 0; --i) {
+        queueSegmentShape(segments[i], i, length, snake.getDirection());
+    }
 
+    if (shapeBatch.flush(*backend)) {
+        ++stats.drawCalls;
+    }
+}
+
+void Renderer::queueSegmentShape(const Position& pos, int index, int length, Direction heading) {
     SDL_Color outlineColor = makeColor(
         Constants::Colors::OUTLINE_R,
         Constants::Colors::OUTLINE_G,
@@ -258,69 +631,438 @@ void Renderer::drawSnake(const Snake& snake) {
         Constants::Colors::OUTLINE_A
     );
 
-    // Draw body segments (back to front for proper overlap)
-    for (size_t i = segments.size() - 1; i > 0; --i) {
-        int x = gridToScreenX(segments[i].x) + 1;
-        int y = gridToScreenY(segments[i].y) + 1;
-
-        // Gradient from body color to darker for tail
-        float fadeRatio = static_cast<float>(i) / segments.size();
-        SDL_Color segColor = {
-            static_cast<Uint8>(bodyColor.r * (0.6f + 0.4f * (1.0f - fadeRatio))),
-            static_cast<Uint8>(bodyColor.g * (0.6f + 0.4f * (1.0f - fadeRatio))),
-            static_cast<Uint8>(bodyColor.b * (0.6f + 0.4f * (1.0f - fadeRatio))),
-            255
-        };
-
-        drawRectWithOutline(x, y, Constants::CELL_SIZE - 2, Constants::CELL_SIZE - 2,
-                           segColor, outlineColor);
+    const float segSize = static_cast<float>(camera.getCellSize() - 2);
+    int x = gridToScreenX(pos.x) + 1;
+    int y = gridToScreenY(pos.y) + 1;
+
+    if (index == 0) {
+        SDL_Color headColor = makeColor(
+            Constants::Colors::HEAD_R,
+            Constants::Colors::HEAD_G,
+            Constants::Colors::HEAD_B,
+            Constants::Colors::HEAD_A
+        );
+        shapeBatch.addOutlinedRect(static_cast<float>(x), static_cast<float>(y),
+                                   segSize, segSize, headColor, outlineColor);
+        queueEyes(x, y, heading);
+        return;
     }
 
-    // Draw head
-    int headX = gridToScreenX(segments[0].x) + 1;
-    int headY = gridToScreenY(segments[0].y) + 1;
-    drawRectWithOutline(headX, headY, Constants::CELL_SIZE - 2, Constants::CELL_SIZE - 2,
-                       headColor, outlineColor);
+    SDL_Color bodyColor = makeColor(
+        Constants::Colors::BODY_R,
+        Constants::Colors::BODY_G,
+        Constants::Colors::BODY_B,
+        Constants::Colors::BODY_A
+    );
+
+    // Gradient from body color to darker for tail, as vertex color
+    float fadeRatio = static_cast<float>(index) / length;
+    SDL_Color segColor = {
+        static_cast<Uint8>(bodyColor.r * (0.6f + 0.4f * (1.0f - fadeRatio))),
+        static_cast<Uint8>(bodyColor.g * (0.6f + 0.4f * (1.0f - fadeRatio))),
+        static_cast<Uint8>(bodyColor.b * (0.6f + 0.4f * (1.0f - fadeRatio))),
+        255
+    };
+
+    shapeBatch.addOutlinedRect(static_cast<float>(x), static_cast<float>(y),
+                               segSize, segSize, segColor, outlineColor);
+}
 
-    // Draw eyes on head
-    Direction dir = snake.getDirection();
+void Renderer::queueEyes(int headX, int headY, Direction dir) {
     int eyeSize = 4;
+    const int cellSize = camera.getCellSize();
 
     SDL_Color eyeColor = makeColor(255, 255, 255, 255);
     SDL_Color pupilColor = makeColor(0, 0, 0, 255);
 
     int eyeX1 = headX + 3, eyeY1 = headY + 3;
-    int eyeX2 = headX + Constants::CELL_SIZE - 8, eyeY2 = headY + 3;
+    int eyeX2 = headX + cellSize - 8, eyeY2 = headY + 3;
 
     switch (dir) {
         case Direction::UP:
             eyeY1 = eyeY2 = headY + 3;
             break;
         case Direction::DOWN:
-            eyeY1 = eyeY2 = headY + Constants::CELL_SIZE - 8;
+            eyeY1 = eyeY2 = headY + cellSize - 8;
             break;
         case Direction::LEFT:
             eyeX1 = eyeX2 = headX + 3;
-            eyeY2 = headY + Constants::CELL_SIZE - 8;
+            eyeY2 = headY + cellSize - 8;
             break;
         case Direction::RIGHT:
-            eyeX1 = eyeX2 = headX + Constants::CELL_SIZE - 8;
-            eyeY2 = headY + Constants::CELL_SIZE - 8;
+            eyeX1 = eyeX2 = headX + cellSize - 8;
+            eyeY2 = headY + cellSize - 8;
             break;
         default:
             break;
     }
 
-    drawRect(eyeX1, eyeY1, eyeSize, eyeSize, eyeColor, true);
-    drawRect(eyeX2, eyeY2, eyeSize, eyeSize, eyeColor, true);
+    shapeBatch.addRect(eyeX1, eyeY1, eyeSize, eyeSize, eyeColor);
+    shapeBatch.addRect(eyeX2, eyeY2, eyeSize, eyeSize, eyeColor);
+
+    // Queue pupils
+    shapeBatch.addRect(eyeX1 + 1, eyeY1 + 1, 2, 2, pupilColor);
+    shapeBatch.addRect(eyeX2 + 1, eyeY2 + 1, 2, 2, pupilColor);
+}
+
+void Renderer::setBoardRenderMode(BoardRenderMode mode) {
+    if (mode == boardRenderMode) return;
+
+    boardRenderMode = mode;
+    if (mode != BoardRenderMode::INCREMENTAL) {
+        destroyBoardLayer();
+    }
+    if (mode != BoardRenderMode::CELL_FRAMEBUFFER) {
+        cellFramebuffer.destroy();
+    }
+    boardTracker.invalidate();
+}
+
+bool Renderer::createBoardLayer() {
+    if (!backgroundLayer) return false; // Needs render targets, like the static layers
+
+    boardLayer = createLayerTexture();
+    if (!boardLayer) return false;
+
+    backend->setTextureBlendMode(boardLayer, SDL_BLENDMODE_NONE);
+    boardTracker.invalidate();
+    return true;
+}
+
+void Renderer::destroyBoardLayer() {
+    if (boardLayer) {
+        backend->destroyTexture(boardLayer);
+        boardLayer = nullptr;
+    }
+}
+
+void Renderer::setBoardSize(int width, int height) {
+    boardTracker.resize(width, height);
+    cellFramebuffer.resize(width, height); // drawBoard creates the texture again
+    camera.setBoardSize(width, height);
+}
+
+void Renderer::drawBoard(const Snake& snake, const Food& food) {
+    // Jump to a new snake, glide after a moving one
+    camera.follow(snake.getHead(), snake.getGeneration() != followedGeneration);
+    followedGeneration = snake.getGeneration();
+
+    if (boardRenderMode == BoardRenderMode::INCREMENTAL && !boardLayer && !createBoardLayer()) {
+        printf("Warning: Render targets unavailable - using full board redraw\n");
+        boardRenderMode = BoardRenderMode::FULL;
+    }
+    if (boardRenderMode == BoardRenderMode::CELL_FRAMEBUFFER && !cellFramebuffer.isReady()) {
+        if (cellFramebuffer.create(*backend)) {
+            boardTracker.invalidate();
+        } else {
+            boardRenderMode = BoardRenderMode::FULL;
+        }
+    }
+
+    if (boardRenderMode == BoardRenderMode::CELL_FRAMEBUFFER) {
+        drawGrid();
+        drawCellFramebuffer(snake, food);
+    } else if (!camera.isIdentity()) {
+        // The board layer and the unculled paths only cover the default view
+        drawCulledBoard(snake, food);
+        return;
+    } else if (boardLayer) {
+        if (boardLayerStale) {
+            boardTracker.invalidate();
+            boardLayerStale = false;
+        }
+        updateBoardLayer(snake);
+        backend->copy(boardLayer, nullptr, nullptr);
+        ++stats.drawCalls;
+    } else if (skin.isReady()) {
+        // Snake and food come from the same texture: one draw call
+        drawGrid();
+        queueSnakeSprites(snake);
+        queueFoodSprite(food);
+        if (shapeBatch.flush(*backend, skin.getTexture())) {
+            ++stats.drawCalls;
+        }
+        return;
+    } else {
+        drawGrid();
+        drawSnake(snake);
+    }
 
-    // Draw pupils
-    drawRect(eyeX1 + 1, eyeY1 + 1, 2, 2, pupilColor, true);
-    drawRect(eyeX2 + 1, eyeY2 + 1, 2, 2, pupilColor, true);
+    // Food pulses every frame and its glow spills over the neighbours, so
+    // it is always drawn on top instead of into the layer
+    bool clip = !camera.isIdentity();
+    if (clip) backend->setClipRect(&camera.getViewport());
+    drawFood(food);
+    if (clip) backend->setClipRect(nullptr);
+}
+
+void Renderer::drawCulledGrid() {
+    drawHudDivider();
+
+    SDL_Rect visible = camera.getVisibleCells();
+    if (visible.w <= 0 || visible.h <= 0) return;
+
+    SDL_Color gridColor = makeColor(
+        Constants::Colors::GRID_R,
+        Constants::Colors::GRID_G,
+        Constants::Colors::GRID_B,
+        Constants::Colors::GRID_A
+    );
+
+    // Lines around the visible cells only, clipped to the viewport, as
+    // one batch of one pixel wide quads
+    const SDL_Rect& view = camera.getViewport();
+    int left = std::max(gridToScreenX(visible.x), view.x);
+    int right = std::min(gridToScreenX(visible.x + visible.w) + 1, view.x + view.w);
+    int top = std::max(gridToScreenY(visible.y), view.y);
+    int bottom = std::min(gridToScreenY(visible.y + visible.h) + 1, view.y + view.h);
+
+    for (int x = visible.x; x <= visible.x + visible.w; ++x) {
+        int screenX = gridToScreenX(x);
+        if (screenX < view.x || screenX >= view.x + view.w) continue;
+        shapeBatch.addRect(static_cast<float>(screenX), static_cast<float>(top),
+                           1.0f, static_cast<float>(bottom - top), gridColor);
+    }
+    for (int y = visible.y; y <= visible.y + visible.h; ++y) {
+        int screenY = gridToScreenY(y);
+        if (screenY < view.y || screenY >= view.y + view.h) continue;
+        shapeBatch.addRect(static_cast<float>(left), static_cast<float>(screenY),
+                           static_cast<float>(right - left), 1.0f, gridColor);
+    }
+
+    if (shapeBatch.flush(*backend)) {
+        ++stats.drawCalls;
+    }
+}
+
+void Renderer::drawCulledBoard(const Snake& snake, const Food& food) {
+    boardTracker.sync(snake);
+    boardLayerStale = true;
+
+    drawGrid();
+
+    backend->setClipRect(&camera.getViewport());
+    queueVisibleSnake(snake);
+
+    // Food too, with a cell of margin for its glow
+    SDL_Rect visible = camera.getVisibleCells();
+    const Position& foodPos = food.getPosition();
+    bool foodVisible = foodPos.x >= visible.x - 1 && foodPos.x <= visible.x + visible.w &&
+                       foodPos.y >= visible.y - 1 && foodPos.y <= visible.y + visible.h;
+
+    // Snake and food in one draw call
+    RenderTexture* texture = nullptr;
+    if (skin.isReady()) {
+        if (foodVisible) queueFoodSprite(food);
+        texture = skin.getTexture();
+    } else if (foodVisible) {
+        queueFoodShapes(food);
+    }
+    if (shapeBatch.flush(*backend, texture)) {
+        ++stats.drawCalls;
+    }
+
+    backend->setClipRect(nullptr);
+}
+
+void Renderer::queueVisibleSnake(const Snake& snake) {
+    SDL_Rect visible = camera.getVisibleCells();
+    if (visible.w <= 0 || visible.h <= 0 || snake.getLength() == 0) return;
+
+    const int chunk = BoardTracker::CHUNK_SIZE;
+    const int last = snake.getLength() - 1;
+    const int visibleRight = visible.x + visible.w;
+    const int visibleBottom = visible.y + visible.h;
+
+    // Walk the visible chunks and skip the empty ones without looking at
+    // their cells
+    for (int chunkY = visible.y / chunk; chunkY <= (visibleBottom - 1) / chunk; ++chunkY) {
+        for (int chunkX = visible.x / chunk; chunkX <= (visibleRight - 1) / chunk; ++chunkX) {
+            if (boardTracker.getChunkCount(chunkX, chunkY) == 0) continue;
+
+            int x0 = std::max(chunkX * chunk, visible.x);
+            int x1 = std::min((chunkX + 1) * chunk, visibleRight);
+            int y0 = std::max(chunkY * chunk, visible.y);
+            int y1 = std::min((chunkY + 1) * chunk, visibleBottom);
+
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    if (boardTracker.getCell(x, y) == CellContent::EMPTY) continue;
+
+                    int index = std::min(boardTracker.getSegmentIndex(x, y), last);
+                    Position pos = {x, y};
+                    if (skin.isReady()) {
+                        Direction toHead = (index > 0) ? neighbourWithIndex(x, y, index - 1)
+                                                       : Direction::NONE;
+                        Direction toTail = (index < last) ? neighbourWithIndex(x, y, index + 1)
+                                                          : Direction::NONE;
+                        queueSegmentSprite(pos, index, last, toHead, toTail, snake.getDirection());
+                    } else {
+                        queueSegmentShape(pos, index, last + 1, snake.getDirection());
+                    }
+                }
+            }
+        }
+    }
+}
+
+Direction Renderer::neighbourWithIndex(int x, int y, int index) const {
+    const struct {
+        int dx;
+        int dy;
+        Direction dir;
+    } neighbours[] = {
+        {0, -1, Direction::UP},
+        {0, 1, Direction::DOWN},
+        {-1, 0, Direction::LEFT},
+        {1, 0, Direction::RIGHT}
+    };
+
+    for (const auto& n : neighbours) {
+        int nx = x + n.dx;
+        int ny = y + n.dy;
+        if (boardTracker.getCell(nx, ny) != CellContent::EMPTY &&
+            boardTracker.getSegmentIndex(nx, ny) == index) {
+            return n.dir;
+        }
+    }
+    return Direction::NONE;
+}
+
+void Renderer::drawCellFramebuffer(const Snake& snake, const Food& food) {
+    bool fullRebuild = boardTracker.sync(snake);
+    cellFramebuffer.sync(boardTracker, fullRebuild, food.getPosition());
+    if (!cellFramebuffer.upload()) {
+        printf("Warning: Could not update cell framebuffer\n");
+    }
+
+    // Only the texels the camera sees, stretched over their cells
+    SDL_Rect visible = camera.getVisibleCells();
+    if (visible.w <= 0 || visible.h <= 0) return;
+
+    SDL_Rect dest = {
+        gridToScreenX(visible.x),
+        gridToScreenY(visible.y),
+        visible.w * camera.getCellSize(),
+        visible.h * camera.getCellSize()
+    };
+    backend->setClipRect(&camera.getViewport());
+    backend->copy(cellFramebuffer.getTexture(), &visible, &dest);
+    backend->setClipRect(nullptr);
+    ++stats.drawCalls;
+}
+
+void Renderer::updateBoardLayer(const Snake& snake) {
+    bool fullRepaint = boardTracker.sync(snake);
+
+    std::vector<CellChange> cells;
+    if (fullRepaint) {
+        // Body back to front, then the head
+        const auto& segments = snake.getSegments();
+        for (size_t i = segments.size(); i-- > 0;) {
+            if (boardTracker.getCell(segments[i].x, segments[i].y) == CellContent::EMPTY) continue;
+            cells.push_back({segments[i], i == 0 ? CellContent::HEAD : CellContent::BODY});
+        }
+    } else {
+        cells = boardTracker.getChanges();
+        if (cells.empty()) return; // Nothing moved since the last frame
+    }
+
+    RenderTexture* previousTarget = backend->getRenderTarget();
+    setTarget(boardLayer);
+
+    if (fullRepaint) {
+        backend->copy(backgroundLayer, nullptr, nullptr);
+        ++stats.drawCalls;
+    } else {
+        // Restore each changed cell from the background layer in one call
+        SDL_Color white = makeColor(255, 255, 255, 255);
+        for (const CellChange& cell : cells) {
+            SDL_FRect dest = {
+                static_cast<float>(gridToScreenX(cell.pos.x)),
+                static_cast<float>(gridToScreenY(cell.pos.y)),
+                static_cast<float>(Constants::CELL_SIZE),
+                static_cast<float>(Constants::CELL_SIZE)
+            };
+            SDL_FRect uv = {
+                dest.x / Constants::WINDOW_WIDTH,
+                dest.y / Constants::WINDOW_HEIGHT,
+                dest.w / Constants::WINDOW_WIDTH,
+                dest.h / Constants::WINDOW_HEIGHT
+            };
+            shapeBatch.addTexturedRect(dest, uv, white);
+        }
+        if (shapeBatch.flush(*backend, backgroundLayer)) {
+            ++stats.drawCalls;
+        }
+    }
+
+    for (const CellChange& cell : cells) {
+        queueBoardCell(cell.pos, cell.content, snake.getDirection());
+    }
+    if (shapeBatch.flush(*backend)) {
+        ++stats.drawCalls;
+    }
+
+    setTarget(previousTarget);
+}
+
+void Renderer::queueBoardCell(const Position& pos, CellContent content, Direction dir) {
+    if (content == CellContent::EMPTY) return;
+
+    const float segSize = static_cast<float>(Constants::CELL_SIZE - 2);
+    int x = gridToScreenX(pos.x) + 1;
+    int y = gridToScreenY(pos.y) + 1;
+
+    SDL_Color outlineColor = makeColor(
+        Constants::Colors::OUTLINE_R,
+        Constants::Colors::OUTLINE_G,
+        Constants::Colors::OUTLINE_B,
+        Constants::Colors::OUTLINE_A
+    );
+
+    if (content == CellContent::HEAD) {
+        SDL_Color headColor = makeColor(
+            Constants::Colors::HEAD_R,
+            Constants::Colors::HEAD_G,
+            Constants::Colors::HEAD_B,
+            Constants::Colors::HEAD_A
+        );
+        shapeBatch.addOutlinedRect(static_cast<float>(x), static_cast<float>(y),
+                                   segSize, segSize, headColor, outlineColor);
+        queueEyes(x, y, dir);
+    } else {
+        SDL_Color bodyColor = makeColor(
+            Constants::Colors::BODY_R,
+            Constants::Colors::BODY_G,
+            Constants::Colors::BODY_B,
+            Constants::Colors::BODY_A
+        );
+        shapeBatch.addOutlinedRect(static_cast<float>(x), static_cast<float>(y),
+                                   segSize, segSize, bodyColor, outlineColor);
+    }
 }
 
 void Renderer::drawFood(const Food& food) {
+    if (skin.isReady()) {
+        queueFoodSprite(food);
+        if (shapeBatch.flush(*backend, skin.getTexture())) {
+            ++stats.drawCalls;
+        }
+        return;
+    }
+
+    queueFoodShapes(food);
+
+    // Triangles blend in submission order, so one call keeps the layering
+    if (shapeBatch.flush(*backend)) {
+        ++stats.drawCalls;
+    }
+}
+
+void Renderer::queueFoodShapes(const Food& food) {
     const Position& pos = food.getPosition();
+    const int cellSize = camera.getCellSize();
     int x = gridToScreenX(pos.x);
     int y = gridToScreenY(pos.y);
 
@@ -328,19 +1070,19 @@ void Renderer::drawFood(const Food& food) {
     float pulse = food.getPulseValue();
     int expansion = static_cast<int>(pulse * 3);
 
-    // Draw glow
+    // Queue glow
     SDL_Color glowColor = makeColor(
         Constants::Colors::FOOD_GLOW_R,
         Constants::Colors::FOOD_GLOW_G,
         Constants::Colors::FOOD_GLOW_B,
         static_cast<uint8_t>(Constants::Colors::FOOD_GLOW_A * pulse)
     );
-    drawRect(x - expansion - 2, y - expansion - 2,
-             Constants::CELL_SIZE + expansion * 2 + 4,
-             Constants::CELL_SIZE + expansion * 2 + 4,
-             glowColor, true);
+    shapeBatch.addRect(x - expansion - 2, y - expansion - 2,
+                       cellSize + expansion * 2 + 4,
+                       cellSize + expansion * 2 + 4,
+                       glowColor);
 
-    // Draw food
+    // Queue food
     SDL_Color foodColor = makeColor(
         Constants::Colors::FOOD_R,
         Constants::Colors::FOOD_G,
@@ -348,14 +1090,133 @@ void Renderer::drawFood(const Food& food) {
         Constants::Colors::FOOD_A
     );
 
-    drawRect(x + 2 - expansion, y + 2 - expansion,
-             Constants::CELL_SIZE - 4 + expansion * 2,
-             Constants::CELL_SIZE - 4 + expansion * 2,
-             foodColor, true);
+    shapeBatch.addRect(x + 2 - expansion, y + 2 - expansion,
+                       cellSize - 4 + expansion * 2,
+                       cellSize - 4 + expansion * 2,
+                       foodColor);
 
-    // Draw highlight
+    // Queue highlight
     SDL_Color highlightColor = makeColor(255, 150, 150, 200);
-    drawRect(x + 4, y + 4, 4, 4, highlightColor, true);
+    shapeBatch.addRect(x + 4, y + 4, 4, 4, highlightColor);
+}
+
+void Renderer::drawParticles(const ParticleSystem& particles) {
+    const int count = particles.getCount();
+    if (count == 0) return;
+
+    const float* x = particles.getX();
+    const float* y = particles.getY();
+    const float* size = particles.getSize();
+    const float* fade = particles.getFade();
+    const SDL_Color* color = particles.getColor();
+
+    // Board cells to screen pixels, as the camera shows them now
+    const float cellSize = static_cast<float>(camera.getCellSize());
+    const float originX = static_cast<float>(camera.cellToScreenX(0));
+    const float originY = static_cast<float>(camera.cellToScreenY(0));
+
+    for (int i = 0; i < count; ++i) {
+        float side = size[i] * cellSize;
+        SDL_Color faded = color[i];
+        faded.a = static_cast<Uint8>(faded.a * std::min(1.0f, std::max(0.0f, fade[i])));
+        shapeBatch.addRect(originX + x[i] * cellSize - side / 2,
+                           originY + y[i] * cellSize - side / 2,
+                           side, side, faded);
+    }
+
+    backend->setClipRect(&camera.getViewport());
+    if (shapeBatch.flush(*backend)) {
+        ++stats.drawCalls;
+    }
+    backend->setClipRect(nullptr);
+}
+
+void Renderer::applyLoadedSkin() {
+    SkinImage* image = skinLoader.takeLoaded();
+    if (!image) return;
+
+    // Upload first so a failure keeps the current look
+    Skin next;
+    if (backend && next.create(*backend, *image)) {
+        skin.swap(next);
+        printf("Using skin '%s'\n", skin.getName().c_str());
+    }
+    delete image;
+}
+
+void Renderer::queueSnakeSprites(const Snake& snake) {
+    const auto& segments = snake.getSegments();
+    if (segments.empty()) return;
+
+    const int last = static_cast<int>(segments.size()) - 1;
+
+    // Tail first so the head ends up on top
+    for (int i = last; i >= 0; --i) {
+        Direction toHead = (i > 0) ? directionTo(segments[i], segments[i - 1]) : Direction::NONE;
+        Direction toTail = (i < last) ? directionTo(segments[i], segments[i + 1]) : Direction::NONE;
+        queueSegmentSprite(segments[i], i, last, toHead, toTail, snake.getDirection());
+    }
+}
+
+void Renderer::queueSegmentSprite(const Position& pos, int index, int last,
+                                  Direction toHead, Direction toTail, Direction heading) {
+    const float size = static_cast<float>(camera.getCellSize());
+    SDL_FRect dest = {
+        static_cast<float>(gridToScreenX(pos.x)),
+        static_cast<float>(gridToScreenY(pos.y)),
+        size, size
+    };
+
+    SkinSprite sprite;
+    int turns;
+    if (index == 0) {
+        sprite = SkinSprite::HEAD;
+        turns = quarterTurns(heading);
+    } else if (index == last) {
+        sprite = SkinSprite::TAIL;
+        turns = quarterTurns(toHead);
+    } else {
+        int headTurns = quarterTurns(toHead);
+        int tailTurns = quarterTurns(toTail);
+        if ((headTurns - tailTurns + 4) % 2 == 0) {
+            sprite = SkinSprite::BODY;
+            turns = headTurns % 2;
+        } else {
+            // The corner picture joins up (0) to right (1)
+            sprite = SkinSprite::CORNER;
+            turns = ((headTurns + 1) % 4 == tailTurns) ? headTurns : tailTurns;
+        }
+    }
+
+    shapeBatch.addTexturedRect(dest, skin.getUV(sprite), makeColor(255, 255, 255, 255), turns);
+}
+
+void Renderer::queueFoodSprite(const Food& food) {
+    const Position& pos = food.getPosition();
+    float x = static_cast<float>(gridToScreenX(pos.x));
+    float y = static_cast<float>(gridToScreenY(pos.y));
+
+    // Glow from the solid block, then the picture grown by the pulse
+    const float size = static_cast<float>(camera.getCellSize());
+    float pulse = food.getPulseValue();
+    float expansion = std::floor(pulse * 3);
+    SDL_Color glowColor = makeColor(
+        Constants::Colors::FOOD_GLOW_R,
+        Constants::Colors::FOOD_GLOW_G,
+        Constants::Colors::FOOD_GLOW_B,
+        static_cast<uint8_t>(Constants::Colors::FOOD_GLOW_A * pulse)
+    );
+    SDL_FRect glow = {
+        x - expansion - 2, y - expansion - 2,
+        size + expansion * 2 + 4, size + expansion * 2 + 4
+    };
+    shapeBatch.addTexturedRect(glow, skin.getUV(SkinSprite::SOLID), glowColor);
+
+    SDL_FRect dest = {
+        x - expansion, y - expansion,
+        size + expansion * 2, size + expansion * 2
+    };
+    shapeBatch.addTexturedRect(dest, skin.getUV(SkinSprite::FOOD), makeColor(255, 255, 255, 255));
 }
 
 void Renderer::drawScore(int score, int highScore) {
@@ -381,11 +1242,14 @@ void Renderer::drawScore(int score, int highScore) {
     drawText("HIGH SCORE", Constants::WINDOW_WIDTH - 120, 10, textColor, false, 16);
     drawText(std::to_string(highScore), Constants::WINDOW_WIDTH - 120, 28, highlightColor, false, 24);
 
-    // Draw separator line
+    // The separator line is part of the grid layer drawn by drawGrid()
+}
+
+void Renderer::drawHudDivider() {
     SDL_Color lineColor = makeColor(50, 50, 80, 255);
-    SDL_SetRenderDrawColor(renderer, lineColor.r, lineColor.g, lineColor.b, lineColor.a);
-    SDL_RenderDrawLine(renderer, 0, Constants::GRID_OFFSET_Y - 2,
-                       Constants::WINDOW_WIDTH, Constants::GRID_OFFSET_Y - 2);
+    backend->drawLine(0, Constants::GRID_OFFSET_Y - 2,
+                      Constants::WINDOW_WIDTH, Constants::GRID_OFFSET_Y - 2, lineColor);
+    ++stats.drawCalls;
 }
 
 void Renderer::drawPlayerInfo(const std::string& initials, int playerNum) {
@@ -400,6 +1264,28 @@ void Renderer::drawPlayerInfo(const std::string& initials, int playerNum) {
     drawText(info, Constants::WINDOW_WIDTH / 2, 10, textColor, true, 16);
 }
 
+void Renderer::drawLoadingScreen(float progress) {
+    SDL_Color barColor = makeColor(
+        Constants::Colors::HIGHLIGHT_R,
+        Constants::Colors::HIGHLIGHT_G,
+        Constants::Colors::HIGHLIGHT_B,
+        Constants::Colors::HIGHLIGHT_A
+    );
+
+    // Shown before the fonts are in, so only rectangles
+    progress = std::min(std::max(progress, 0.0f), 1.0f);
+    const int barWidth = Constants::WINDOW_WIDTH / 2;
+    const int barHeight = 12;
+    const int x = (Constants::WINDOW_WIDTH - barWidth) / 2;
+    const int y = (Constants::WINDOW_HEIGHT - barHeight) / 2;
+
+    drawRect(x - 3, y - 3, barWidth + 6, barHeight + 6, barColor, false);
+    int filled = static_cast<int>(barWidth * progress);
+    if (filled > 0) {
+        drawRect(x, y, filled, barHeight, barColor, true);
+    }
+}
+
 void Renderer::drawTitleScreen() {
     SDL_Color titleColor = makeColor(
         Constants::Colors::HIGHLIGHT_R,
@@ -559,7 +1445,8 @@ void Renderer::drawInitialsEntry(const std::string& initials, int playerNum, int
         }
 
         // Draw cursor
-        if (i == cursorPos && (frameCount / 30) % 2 == 0) {
+        // Blink on the clock, not the frame count: idle screens draw rarely
+        if (i == cursorPos && (SDL_GetTicks() / Constants::CURSOR_BLINK_MS) % 2 == 0) {
             drawRect(x + 10, y + boxHeight - 15, boxWidth - 20, 4, titleColor, true);
         }
     }
@@ -593,7 +1480,7 @@ void Renderer::drawPauseScreen() {
     drawText("Press ESC or B to quit", Constants::WINDOW_WIDTH / 2, 385, textColor, true, 16);
 }
 
-void Renderer::drawGameOver(int score, bool isHighScore) {
+void Renderer::drawGameOver(int score, bool isHighScore, size_t rank, size_t count) {
     SDL_Color titleColor = makeColor(255, 50, 50, 255); // Red for game over
 
     SDL_Color textColor = makeColor(
@@ -619,6 +1506,11 @@ void Renderer::drawGameOver(int score, bool isHighScore) {
         drawText("NEW HIGH SCORE!", Constants::WINDOW_WIDTH / 2, 380, highlightColor, true, 24);
     }
 
+    if (rank > 0) {
+        std::string rankText = "RANK " + groupDigits(rank) + " OF " + groupDigits(count);
+        drawText(rankText, Constants::WINDOW_WIDTH / 2, 420, textColor, true, 20);
+    }
+
     drawText("Press ENTER or A to continue", Constants::WINDOW_WIDTH / 2, 480, textColor, true, 20);
 }
 
@@ -750,8 +1642,9 @@ void Renderer::drawFinalResults(const std::string& p1Initials, int p1Score,
 }
 
 void Renderer::drawScanlines() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 30);
+    SDL_Color lineColor = makeColor(0, 0, 0, 30);
     for (int y = 0; y < Constants::WINDOW_HEIGHT; y += 3) {
-        SDL_RenderDrawLine(renderer, 0, y, Constants::WINDOW_WIDTH, y);
+        backend->drawLine(0, y, Constants::WINDOW_WIDTH, y, lineColor);
+        ++stats.drawCalls;
     }
 }
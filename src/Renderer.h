@@ -3,20 +3,59 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 #include "Constants.h"
 #include "Snake.h"
 #include "Food.h"
 #include "HighScoreManager.h"
+#include "BoardTracker.h"
+#include "Camera.h"
+#include "CellFramebuffer.h"
+#include "GlyphAtlas.h"
+#include "ParticleSystem.h"
+#include "RenderBackend.h"
+#include "RenderBatch.h"
+#include "Skin.h"
+#include "StartupTimeline.h"
+#include "TextCache.h"
+
+// Cumulative renderer counters (see Renderer::getStats)
+struct RenderStats {
+    Uint64 frames;         // Calls to clear()
+    Uint64 drawCalls;      // Backend draw submissions (clear, fill, line, copy)
+    Uint64 textRenders;    // Strings rasterized with SDL_ttf (atlas fallback)
+
+    RenderStats() : frames(0), drawCalls(0), textRenders(0) {}
+};
 
 class Renderer {
 public:
     Renderer();
     ~Renderer();
 
-    // Initialize renderer
-    bool init();
+    // Initialize renderer with a window. The software backend draws on the
+    // CPU and shows the result in the window without a GPU.
+    bool init(RenderBackendType type = RenderBackendType::SDL);
+
+    // Like init, but return as soon as the window is up: the fonts are
+    // opened on a loader thread meanwhile, so a loading screen can be
+    // shown. No text is drawn until finishLoading has taken them.
+    bool initWindow(RenderBackendType type, StartupTimeline& timeline);
+
+    // Take the fonts if the loader is done; never waits. Returns true once
+    // loading is over, hasFonts tells whether it worked.
+    bool finishLoading();
+    bool hasFonts() const { return fontMedium != nullptr; }
+
+    // Initialize without a window (no display or GPU needed). The software
+    // backend draws into a memory framebuffer of the given size (see
+    // readPixels); the null backend discards everything.
+    bool initHeadless(int width = Constants::WINDOW_WIDTH,
+                      int height = Constants::WINDOW_HEIGHT,
+                      RenderBackendType type = RenderBackendType::SOFTWARE);
 
     // Shutdown renderer
     void shutdown();
@@ -27,35 +66,162 @@ public:
     // Present rendered frame
     void present();
 
-    // Draw game elements
+    // Enable the retro scanline overlay (off by default)
+    void setScanlines(bool enabled) { scanlinesEnabled = enabled; }
+
+    // Draw game elements. drawGrid draws the whole static playfield
+    // (background, grid and HUD divider) as one pre-composited layer.
     void drawGrid();
     void drawSnake(const Snake& snake);
     void drawFood(const Food& food);
     void drawScore(int score, int highScore);
     void drawPlayerInfo(const std::string& initials, int playerNum);
 
+    // Draw every live particle in one batch, clipped to the playfield
+    void drawParticles(const ParticleSystem& particles);
+
+    // Draw the whole playfield: grid, snake and food. In INCREMENTAL mode
+    // the grid and snake live in a persistent layer where only the cells
+    // that changed since the last frame are repainted; the body is drawn
+    // in a flat color there because the gradient would change every cell.
+    // In CELL_FRAMEBUFFER mode the snake is one texel per cell, stretched
+    // over the grid.
+    void drawBoard(const Snake& snake, const Food& food);
+    void setBoardRenderMode(BoardRenderMode mode);
+    BoardRenderMode getBoardRenderMode() const { return boardRenderMode; }
+
+    // One pixel per cell copy of the board as last drawn in
+    // CELL_FRAMEBUFFER mode (e.g. for thumbnails)
+    const CellFramebuffer& getCellFramebuffer() const { return cellFramebuffer; }
+
+    // Force a full repaint of the board layer on the next drawBoard
+    void invalidateBoard() { boardTracker.invalidate(); }
+
+    // Board size in cells (default GRID_WIDTH x GRID_HEIGHT, which fills
+    // the window). On a bigger board, or when zoomed, the camera follows
+    // the head and only the cells in view are drawn; INCREMENTAL mode then
+    // draws like FULL because its layer only covers the unscrolled board.
+    void setBoardSize(int width, int height);
+    Camera& getCamera() { return camera; }
+
+    // Draw the snake and food with the pictures in
+    // assets/images/skins/<name>. The skin loads in the background; the
+    // plain shapes are drawn until it is ready, then it takes over at the
+    // start of a frame. Skins are used in FULL board mode and for food.
+    void loadSkin(const std::string& name) { skinLoader.load(name); }
+    const Skin& getSkin() const { return skin; }
+
     // Draw UI screens
+    void drawLoadingScreen(float progress); // 0..1, needs no fonts
     void drawTitleScreen();
     void drawMenu(int selectedOption);
     void drawPlayerSelect(int selectedOption);
     void drawInitialsEntry(const std::string& initials, int playerNum, int cursorPos);
     void drawPauseScreen();
-    void drawGameOver(int score, bool isHighScore);
+    // rank of count among all scores ever played; rank 0 hides it
+    void drawGameOver(int score, bool isHighScore, size_t rank, size_t count);
     void drawHighScores(const std::vector<HighScoreEntry>& scores);
     void drawPlayerSwitch(int playerNum, const std::string& initials);
     void drawFinalResults(const std::string& p1Initials, int p1Score,
                           const std::string& p2Initials, int p2Score);
 
-    // Get window for event handling
-    SDL_Window* getWindow() const { return window; }
+    // Window size and mode. Drawing always uses the WINDOW_WIDTH x
+    // WINDOW_HEIGHT logical layout; a bigger, fullscreen or high-DPI window
+    // shows it at a whole-number scale. Text and the static layers are
+    // rebuilt at that scale (up to MAX_PIXEL_SCALE) when it changes, so
+    // they stay sharp without any per-frame cost.
+    void setFullscreen(bool fullscreen);
+    bool isFullscreen() const;
+    int getPixelScale() const { return pixelScale; }
+
+    // Call when the window was resized or moved to another display
+    void handleOutputResize();
+
+    // Call when render target contents were lost (SDL_RENDER_TARGETS_RESET),
+    // or every texture was (SDL_RENDER_DEVICE_RESET, deviceLost true)
+    void handleRenderReset(bool deviceLost);
+
+    // Get window for event handling (nullptr when headless)
+    SDL_Window* getWindow() const { return backend ? backend->getWindow() : nullptr; }
+
+    // Backend doing the drawing (nullptr before init)
+    RenderBackend* getBackend() const { return backend.get(); }
+
+    // Copy the last drawn frame as ARGB8888 pixels; false if the backend
+    // has no pixels (null backend)
+    bool readPixels(void* pixels, int pitch);
+    int getOutputWidth() const { return outputWidth; }
+    int getOutputHeight() const { return outputHeight; }
+
+    // Draw statistics
+    const RenderStats& getStats() const { return stats; }
+    void resetStats() {
+        stats = RenderStats();
+        textCache.resetCounters();
+    }
+
+    // Rendered text cache (hit/miss counters, memory use)
+    const TextCache& getTextCache() const { return textCache; }
 
 private:
+    // Every font size, opened at one pixel scale
+    struct FontSet {
+        TTF_Font* fontSmall;
+        TTF_Font* fontMedium;
+        TTF_Font* fontLarge;
+        TTF_Font* fontTitle;
+        int scale;
+    };
+
+    // Shared part of init and initHeadless
+    bool initBackend(std::unique_ptr<RenderBackend> newBackend, int width, int height);
+
+    // Create the output and initialize SDL_ttf (no fonts yet)
+    bool startBackend(std::unique_ptr<RenderBackend> newBackend, int width, int height);
+
+    // Load fonts and build their atlases
+    bool loadFonts();
+
+    // Open every font size at the pixel scale, or close them all
+    bool openFonts();
+    void closeFonts();
+
+    // Open every font size at a scale with SDL_ttf alone, so it can run on
+    // the loader thread. Sizes that fail are borrowed from another size;
+    // false (and nothing open) if no font could be found.
+    static bool openFontSet(int scale, FontSet& fonts);
+
+    // Make a font set the current fonts
+    void useFonts(const FontSet& fonts);
+
+    // Wait for fonts still being opened and take them
+    void waitForFonts();
+
+    // Recreate fonts, atlases, cached text and layers at the pixel scale
+    void rebuildScaledResources();
+
+    // Select a render target (nullptr = output); textures are drawn at
+    // the pixel scale
+    void setTarget(RenderTexture* texture);
+
+    // Texture to draw a WINDOW_WIDTH x WINDOW_HEIGHT layer into
+    RenderTexture* createLayerTexture();
+
+    // Rasterize each font size into its glyph atlas
+    void buildGlyphAtlases();
+
+    // Font and atlas used for a requested text size
+    TTF_Font* fontForSize(int fontSize) const;
+    const GlyphAtlas& atlasForSize(int fontSize) const;
+
+    // Rasterize a whole string into a new texture for the text cache
+    RenderTexture* renderTextTexture(const std::string& text, int fontSize, SDL_Color color,
+                                   int* width, int* height);
+
     // Helper methods
     void drawText(const std::string& text, int x, int y, SDL_Color color,
                   bool centered = false, int fontSize = 24);
     void drawRect(int x, int y, int w, int h, SDL_Color color, bool filled = true);
-    void drawRectWithOutline(int x, int y, int w, int h,
-                             SDL_Color fillColor, SDL_Color outlineColor);
     SDL_Color makeColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
 
     // Grid to screen coordinates
@@ -65,15 +231,104 @@ private:
     // Draw scanline effect for retro look
     void drawScanlines();
 
-    SDL_Window* window;
-    SDL_Renderer* renderer;
+    // Line-by-line versions of the static layers, used to build them and
+    // as a fallback when render targets are unsupported
+    void drawGridLines();
+    void drawHudDivider();
+
+    // Composite the never-changing background and scanlines into textures
+    // (at init, and again whenever the output is resized)
+    void buildStaticLayers();
+    void destroyStaticLayers();
+
+    // Bring the cell framebuffer up to date and draw it over the grid
+    void drawCellFramebuffer(const Snake& snake, const Food& food);
+
+    // Incremental board layer
+    bool createBoardLayer();
+    void destroyBoardLayer();
+    void updateBoardLayer(const Snake& snake);
+
+    // Queue one snake cell as the board layer shows it
+    void queueBoardCell(const Position& pos, CellContent content, Direction dir);
+
+    // Queue the eyes of a head whose top-left corner is at (headX, headY)
+    void queueEyes(int headX, int headY, Direction dir);
+
+    // Queue one segment as a shape; index 0 is the head
+    void queueSegmentShape(const Position& pos, int index, int length, Direction heading);
+
+    // Queue the food shapes (glow, food, highlight)
+    void queueFoodShapes(const Food& food);
+
+    // Scrolled or zoomed board: draw only what the camera sees
+    void drawCulledGrid();
+    void drawCulledBoard(const Snake& snake, const Food& food);
+    void queueVisibleSnake(const Snake& snake);
+
+    // Neighbour of a tracked cell holding the given body index, or NONE
+    Direction neighbourWithIndex(int x, int y, int index) const;
+
+    // Upload a skin the loader has finished and switch to it
+    void applyLoadedSkin();
+
+    // Queue the snake and food as skin sprites (one texture for both)
+    void queueSnakeSprites(const Snake& snake);
+    void queueFoodSprite(const Food& food);
+
+    // Queue the sprite for body index `index` of a snake whose tail is at
+    // index `last`, given the directions to its neighbours
+    void queueSegmentSprite(const Position& pos, int index, int last,
+                            Direction toHead, Direction toTail, Direction heading);
+
+    std::unique_ptr<RenderBackend> backend;
+    int outputWidth;
+    int outputHeight;
+    int pixelScale; // Texture pixels per logical pixel
     TTF_Font* fontSmall;
     TTF_Font* fontMedium;
     TTF_Font* fontLarge;
     TTF_Font* fontTitle;
+    std::future<FontSet> fontLoad; // Fonts being opened by initWindow
+
+    // Pre-rasterized glyphs for each font, and the batch strings are built in
+    GlyphAtlas atlasSmall;
+    GlyphAtlas atlasMedium;
+    GlyphAtlas atlasLarge;
+    GlyphAtlas atlasTitle;
+    RenderBatch textBatch;
+
+    // Snake and food shapes, submitted once per object per frame
+    RenderBatch shapeBatch;
+
+    // Retained textures for strings that repeat from frame to frame
+    TextCache textCache;
+
+    // Pre-composited static layers
+    RenderTexture* backgroundLayer; // Background, grid and HUD divider (opaque)
+    RenderTexture* scanlineLayer;   // Scanline overlay (translucent)
+    bool scanlinesEnabled;
+
+    // Persistent playfield for INCREMENTAL mode
+    BoardRenderMode boardRenderMode;
+    RenderTexture* boardLayer;
+    BoardTracker boardTracker;
+
+    // Board texture for CELL_FRAMEBUFFER mode
+    CellFramebuffer cellFramebuffer;
+
+    // View of boards that do not fit the window
+    Camera camera;
+    uint32_t followedGeneration; // Snake the camera last followed
+    bool boardLayerStale;        // Tracker synced without repainting the layer
+
+    // Sprite skin (not ready until one has loaded)
+    SkinLoader skinLoader;
+    Skin skin;
 
     bool initialized;
     int frameCount; // For animations
+    RenderStats stats;
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,230 @@
+#include "SDLRenderBackend.h"
+#include <algorithm>
+#include <cstdio>
+#include "Constants.h"
+
+namespace {
+
+// RenderTexture is only ever an SDL_Texture in this backend
+SDL_Texture* toSDL(RenderTexture* texture) {
+    return reinterpret_cast<SDL_Texture*>(texture);
+}
+
+RenderTexture* fromSDL(SDL_Texture* texture) {
+    return reinterpret_cast<RenderTexture*>(texture);
+}
+
+} // namespace
+
+SDLRenderBackend::SDLRenderBackend()
+    : window(nullptr)
+    , renderer(nullptr)
+    , logicalWidth(0)
+    , logicalHeight(0)
+    , pixelScale(1) {
+}
+
+SDLRenderBackend::~SDLRenderBackend() {
+    shutdown();
+}
+
+bool SDLRenderBackend::init(int width, int height) {
+    // Initialize SDL video
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+        printf("Error: Could not initialize SDL video: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Create window
+    window = SDL_CreateWindow(
+        Constants::WINDOW_TITLE,
+        SDL_WINDOWPOS_CENTERED,
+        SDL_WINDOWPOS_CENTERED,
+        width,
+        height,
+        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI
+    );
+
+    if (!window) {
+        printf("Error: Could not create window: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Create renderer with vsync
+    renderer = SDL_CreateRenderer(window, -1,
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+    if (!renderer) {
+        printf("Error: Could not create renderer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Set blend mode for transparency
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // Keep drawing in window coordinates at any window size; never shrink
+    // below one output pixel per logical pixel
+    logicalWidth = width;
+    logicalHeight = height;
+    SDL_SetWindowMinimumSize(window, width, height);
+    SDL_RenderSetLogicalSize(renderer, width, height);
+    SDL_RenderSetIntegerScale(renderer, SDL_TRUE);
+    pixelScale = 1;
+    updatePixelScale();
+    return true;
+}
+
+bool SDLRenderBackend::updatePixelScale() {
+    int outputWidth = 0;
+    int outputHeight = 0;
+    if (!renderer || SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight) < 0) {
+        return false;
+    }
+
+    // Same rule as SDL's integer scaling: the largest whole factor that fits
+    int scale = std::max(1, std::min(outputWidth / logicalWidth, outputHeight / logicalHeight));
+    if (scale == pixelScale) return false;
+
+    pixelScale = scale;
+    return true;
+}
+
+void SDLRenderBackend::setTargetScale(int scale) {
+    // The window's scale belongs to the logical size
+    if (!SDL_GetRenderTarget(renderer)) return;
+    SDL_RenderSetScale(renderer, static_cast<float>(scale), static_cast<float>(scale));
+}
+
+void SDLRenderBackend::shutdown() {
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+}
+
+void SDLRenderBackend::clear(SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderClear(renderer);
+}
+
+void SDLRenderBackend::present() {
+    SDL_RenderPresent(renderer);
+}
+
+void SDLRenderBackend::setDrawBlendMode(SDL_BlendMode mode) {
+    SDL_SetRenderDrawBlendMode(renderer, mode);
+}
+
+void SDLRenderBackend::setClipRect(const SDL_Rect* rect) {
+    SDL_RenderSetClipRect(renderer, rect);
+}
+
+void SDLRenderBackend::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+}
+
+void SDLRenderBackend::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderDrawRect(renderer, &rect);
+}
+
+void SDLRenderBackend::drawLine(int x1, int y1, int x2, int y2, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
+
+bool SDLRenderBackend::drawGeometry(RenderTexture* texture,
+                                    const SDL_Vertex* vertices, int numVertices,
+                                    const int* indices, int numIndices) {
+    return SDL_RenderGeometry(renderer, toSDL(texture), vertices, numVertices,
+                              indices, numIndices) == 0;
+}
+
+void SDLRenderBackend::copy(RenderTexture* texture, const SDL_Rect* src, const SDL_Rect* dest) {
+    SDL_RenderCopy(renderer, toSDL(texture), src, dest);
+}
+
+RenderTexture* SDLRenderBackend::createTexture(int width, int height, TextureAccess access) {
+    int sdlAccess = SDL_TEXTUREACCESS_STATIC;
+    if (access == TextureAccess::STREAMING) sdlAccess = SDL_TEXTUREACCESS_STREAMING;
+    if (access == TextureAccess::TARGET) sdlAccess = SDL_TEXTUREACCESS_TARGET;
+
+    return fromSDL(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, sdlAccess,
+                                     width, height));
+}
+
+RenderTexture* SDLRenderBackend::createTextureFromSurface(SDL_Surface* surface) {
+    return fromSDL(SDL_CreateTextureFromSurface(renderer, surface));
+}
+
+void SDLRenderBackend::destroyTexture(RenderTexture* texture) {
+    if (texture) SDL_DestroyTexture(toSDL(texture));
+}
+
+bool SDLRenderBackend::updateTexture(RenderTexture* texture, const SDL_Rect* rect,
+                                     const void* pixels, int pitch) {
+    return SDL_UpdateTexture(toSDL(texture), rect, pixels, pitch) == 0;
+}
+
+void SDLRenderBackend::setTextureBlendMode(RenderTexture* texture, SDL_BlendMode mode) {
+    SDL_SetTextureBlendMode(toSDL(texture), mode);
+}
+
+void SDLRenderBackend::setTextureScaleMode(RenderTexture* texture, SDL_ScaleMode mode) {
+    SDL_SetTextureScaleMode(toSDL(texture), mode);
+}
+
+bool SDLRenderBackend::supportsRenderTargets() const {
+    return renderer && SDL_RenderTargetSupported(renderer);
+}
+
+bool SDLRenderBackend::setRenderTarget(RenderTexture* texture) {
+    return SDL_SetRenderTarget(renderer, toSDL(texture)) == 0;
+}
+
+RenderTexture* SDLRenderBackend::getRenderTarget() const {
+    return fromSDL(SDL_GetRenderTarget(renderer));
+}
+
+bool SDLRenderBackend::readPixels(const SDL_Rect* rect, void* pixels, int pitch) {
+    // Ask SDL for the window's current scale: the pixel scale is only
+    // updated once the resize event has been handled
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+    int scale = std::max(1, static_cast<int>(scaleX));
+
+    if (SDL_GetRenderTarget(renderer) || (!rect && scale == 1)) {
+        return SDL_RenderReadPixels(renderer, rect, SDL_PIXELFORMAT_ARGB8888, pixels, pitch) == 0;
+    }
+
+    SDL_Rect area = rect ? *rect : SDL_Rect{0, 0, logicalWidth, logicalHeight};
+    if (area.x < 0 || area.y < 0 || area.w <= 0 || area.h <= 0 ||
+        area.x + area.w > logicalWidth || area.y + area.h > logicalHeight) {
+        return false;
+    }
+
+    // Read the whole letterboxed viewport and keep one pixel per block
+    int fullWidth = logicalWidth * scale;
+    readBuffer.resize(static_cast<size_t>(fullWidth) * logicalHeight * scale);
+    if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, readBuffer.data(),
+                             fullWidth * static_cast<int>(sizeof(Uint32))) < 0) {
+        return false;
+    }
+
+    Uint8* out = static_cast<Uint8*>(pixels);
+    for (int y = 0; y < area.h; ++y) {
+        const Uint32* in = &readBuffer[static_cast<size_t>(area.y + y) * scale * fullWidth];
+        Uint32* row = reinterpret_cast<Uint32*>(out + static_cast<size_t>(y) * pitch);
+        for (int x = 0; x < area.w; ++x) {
+            row[x] = in[(area.x + x) * scale];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef SDLRENDERBACKEND_H
+#define SDLRENDERBACKEND_H
+
+#include <vector>
+#include "RenderBackend.h"
+
+// Draws with an SDL_Renderer in a window, GPU accelerated with vsync when
+// the platform allows. The window is resizable and high-DPI aware; the
+// logical size passed to init is shown at the largest whole-number scale
+// that fits (SDL_RenderSetLogicalSize with integer scaling).
+class SDLRenderBackend : public RenderBackend {
+public:
+    SDLRenderBackend();
+    ~SDLRenderBackend() override;
+
+    bool init(int width, int height) override;
+    void shutdown() override;
+    const char* getName() const override { return "sdl"; }
+    SDL_Window* getWindow() const override { return window; }
+    int getPixelScale() const override { return pixelScale; }
+    bool updatePixelScale() override;
+    void setTargetScale(int scale) override;
+
+    void clear(SDL_Color color) override;
+    void present() override;
+    void setDrawBlendMode(SDL_BlendMode mode) override;
+    void setClipRect(const SDL_Rect* rect) override;
+
+    void fillRect(const SDL_Rect& rect, SDL_Color color) override;
+    void drawRect(const SDL_Rect& rect, SDL_Color color) override;
+    void drawLine(int x1, int y1, int x2, int y2, SDL_Color color) override;
+    bool drawGeometry(RenderTexture* texture,
+                      const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices) override;
+    void copy(RenderTexture* texture, const SDL_Rect* src, const SDL_Rect* dest) override;
+
+    RenderTexture* createTexture(int width, int height, TextureAccess access) override;
+    RenderTexture* createTextureFromSurface(SDL_Surface* surface) override;
+    void destroyTexture(RenderTexture* texture) override;
+    bool updateTexture(RenderTexture* texture, const SDL_Rect* rect,
+                       const void* pixels, int pitch) override;
+    void setTextureBlendMode(RenderTexture* texture, SDL_BlendMode mode) override;
+    void setTextureScaleMode(RenderTexture* texture, SDL_ScaleMode mode) override;
+
+    bool supportsRenderTargets() const override;
+    bool setRenderTarget(RenderTexture* texture) override;
+    RenderTexture* getRenderTarget() const override;
+
+    bool readPixels(const SDL_Rect* rect, void* pixels, int pitch) override;
+
+private:
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    int logicalWidth;
+    int logicalHeight;
+    int pixelScale;
+    std::vector<Uint32> readBuffer; // Full resolution pixels for readPixels
+};
+
+#endif // SDLRENDERBACKEND_H
@@ -0,0 +1,48 @@
+#ifndef SCOREFILEFORMAT_H
+#define SCOREFILEFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "ByteOrder.h"
+#include "Leaderboard.h"
+
+// Layout of the score file (highscores.dat). All numbers are little-endian.
+//
+//   Header   MAGIC, VERSION (u32), RECORD_SIZE (u32), sorted count (u64),
+//            next order (u32), reserved (u32)
+//   Sorted   sorted count records, in leaderboard order
+//   Tail     records added since the file was last compacted, in the order
+//            they were played; a partial record at the end (a torn
+//            append) is ignored
+//
+// A record is a LeaderboardEntry: key (u64), initials (4 bytes), date
+// (12 bytes), the text fields NUL padded.
+namespace ScoreFileFormat {
+
+constexpr char MAGIC[8] = {'S', 'N', 'A', 'K', 'S', 'C', 'O', 'R'};
+constexpr uint32_t VERSION = 1;
+
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t RECORD_SIZE = 24;
+
+using ByteOrder::readU32;
+using ByteOrder::readU64;
+using ByteOrder::writeU32;
+using ByteOrder::writeU64;
+
+inline void readRecord(const unsigned char* p, LeaderboardEntry& entry) {
+    entry.key = readU64(p);
+    std::memcpy(entry.initials, p + 8, sizeof(entry.initials));
+    std::memcpy(entry.date, p + 12, sizeof(entry.date));
+}
+
+inline void writeRecord(unsigned char* p, const LeaderboardEntry& entry) {
+    writeU64(p, entry.key);
+    std::memcpy(p + 8, entry.initials, sizeof(entry.initials));
+    std::memcpy(p + 12, entry.date, sizeof(entry.date));
+}
+
+} // namespace ScoreFileFormat
+
+#endif // SCOREFILEFORMAT_H
@@ -0,0 +1,400 @@
+#include "ScoreStore.h"
+#include <algorithm>
+#include <cstdio>
+#include "ScoreFileFormat.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace ScoreFileFormat;
+
+namespace {
+
+bool fileExists(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fclose(file);
+    return true;
+}
+
+bool truncateFile(const std::string& path, size_t size) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _chsize_s(fd, static_cast<long long>(size)) == 0;
+    return _close(fd) == 0 && ok;
+#else
+    return ::truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+bool keyLess(const LeaderboardEntry& a, const LeaderboardEntry& b) {
+    return a.key < b.key;
+}
+
+// Check a score file's header and count its records
+bool readHeader(const unsigned char* data, size_t size, size_t& sorted, size_t& recent,
+                uint32_t& nextOrder) {
+    if (!data || size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        readU32(data + 8) != VERSION || readU32(data + 12) != RECORD_SIZE) {
+        return false;
+    }
+
+    const uint64_t count = readU64(data + 16);
+    const size_t records = (size - HEADER_SIZE) / RECORD_SIZE;
+    if (count > records) return false;
+
+    sorted = static_cast<size_t>(count);
+    recent = records - sorted;
+    nextOrder = readU32(data + 24);
+    return true;
+}
+
+void writeHeader(unsigned char* header, uint64_t sorted, uint32_t nextOrder) {
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    writeU32(header + 8, VERSION);
+    writeU32(header + 12, RECORD_SIZE);
+    writeU64(header + 16, sorted);
+    writeU32(header + 24, nextOrder);
+    writeU32(header + 28, 0);
+}
+
+// Gathers records into large writes
+class RecordWriter {
+public:
+    explicit RecordWriter(const HighScoreWriter::FileSink& sink) : sink(sink), ok(true) {
+        buffer.reserve(BUFFER_BYTES);
+    }
+
+    void add(const LeaderboardEntry& entry) {
+        unsigned char record[RECORD_SIZE];
+        writeRecord(record, entry);
+        addRaw(record);
+    }
+
+    void addRaw(const unsigned char* record) {
+        buffer.insert(buffer.end(), record, record + RECORD_SIZE);
+        if (buffer.size() >= BUFFER_BYTES) flush();
+    }
+
+    bool finish() {
+        flush();
+        return ok;
+    }
+
+private:
+    static constexpr size_t BUFFER_BYTES = 4096 * RECORD_SIZE;
+
+    void flush() {
+        if (ok && !buffer.empty()) ok = sink(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    const HighScoreWriter::FileSink& sink;
+    std::vector<unsigned char> buffer;
+    bool ok;
+};
+
+} // namespace
+
+ScoreStore::ScoreStore(const std::string& path)
+    : path(path)
+    , sortedCount(0)
+    , nextOrder(0)
+    , compactedBefore(0)
+    , opened(false)
+    , created(false)
+    , writer(path) {
+}
+
+ScoreStore::~ScoreStore() {
+    close();
+}
+
+bool ScoreStore::open() {
+    close();
+    opened = true;
+
+    // The file has every score, so a compaction a crash cut off is just
+    // thrown away
+    const std::string compactedPath = writer.getCompactedPath();
+    std::remove((compactedPath + ".tmp").c_str());
+    std::remove(compactedPath.c_str());
+
+    if (!fileExists(path)) {
+        created = true;
+        return true;
+    }
+
+    if (mapFile(true)) {
+        if (recent.size() >= COMPACT_AFTER) startCompaction();
+        return true;
+    }
+
+    // Keep the damaged file to look at, and start again
+    const std::string aside = path + ".damaged";
+    printf("Warning: High score file %s is damaged, moved it to %s\n", path.c_str(), aside.c_str());
+    HighScoreWriter::replace(path, aside);
+    created = true;
+    return false;
+}
+
+void ScoreStore::close() {
+    if (opened) {
+        writer.flush();
+        file.close();
+        writer.finishCompaction();
+        writer.takeCompacted();
+    }
+
+    recent.clear();
+    sortedCount = 0;
+    nextOrder = 0;
+    opened = false;
+    created = false;
+}
+
+bool ScoreStore::mapFile(bool readRecent) {
+    size_t recentCount = 0;
+    uint32_t fileNextOrder = 0;
+    sortedCount = 0;
+    if (!file.open(path) ||
+        !readHeader(file.getData(), file.getSize(), sortedCount, recentCount, fileNextOrder)) {
+        file.close();
+        sortedCount = 0;
+        return false;
+    }
+    nextOrder = std::max(nextOrder, fileNextOrder);
+    if (!readRecent) return true;
+
+    // A torn append leaves part of a record at the end; cut it off so the
+    // next append lines up
+    const size_t used = HEADER_SIZE + (sortedCount + recentCount) * RECORD_SIZE;
+    if (file.getSize() > used) {
+        printf("Warning: Dropped a partly written score from the end of %s\n", path.c_str());
+        file.close();
+        if (!truncateFile(path, used) || !file.open(path)) {
+            file.close();
+            sortedCount = 0;
+            return false;
+        }
+    }
+
+    std::vector<LeaderboardEntry> entries(recentCount);
+    const unsigned char* records = file.getData() + HEADER_SIZE + sortedCount * RECORD_SIZE;
+    for (size_t i = 0; i < recentCount; ++i) {
+        readRecord(records + i * RECORD_SIZE, entries[i]);
+        nextOrder = std::max(nextOrder, Leaderboard::orderOf(entries[i]) + 1);
+    }
+    recent.buildKeyed(std::move(entries));
+    return true;
+}
+
+uint64_t ScoreStore::sortedKey(size_t index) const {
+    return readU64(file.getData() + HEADER_SIZE + index * RECORD_SIZE);
+}
+
+LeaderboardEntry ScoreStore::sortedEntry(size_t index) const {
+    LeaderboardEntry entry;
+    readRecord(file.getData() + HEADER_SIZE + index * RECORD_SIZE, entry);
+    return entry;
+}
+
+size_t ScoreStore::sortedBefore(uint64_t key) const {
+    size_t low = 0;
+    size_t high = sortedCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (sortedKey(middle) < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+size_t ScoreStore::add(LeaderboardEntry entry) {
+    if (file.isOpen()) takeCompaction(false);
+
+    entry.key = (entry.key & ~uint64_t(UINT32_MAX)) | nextOrder++;
+    const size_t position = sortedBefore(entry.key) + recent.insertKeyed(entry);
+    if (!file.isOpen()) return position; // Only in memory
+
+    unsigned char record[RECORD_SIZE];
+    writeRecord(record, entry);
+    writer.append(std::string(reinterpret_cast<const char*>(record), RECORD_SIZE));
+    // Every COMPACT_AFTER scores, so a failed compaction isn't retried on every add
+    if (recent.size() % COMPACT_AFTER == 0) startCompaction();
+    return position;
+}
+
+void ScoreStore::addAll(std::vector<LeaderboardEntry> entries) {
+    // Straight into an empty table in memory; saved tables add one by one
+    if (!file.isOpen() && size() == 0) {
+        for (LeaderboardEntry& entry : entries) {
+            entry.key = (entry.key & ~uint64_t(UINT32_MAX)) | nextOrder++;
+        }
+        recent.buildKeyed(std::move(entries));
+        return;
+    }
+
+    for (const LeaderboardEntry& entry : entries) {
+        add(entry);
+    }
+}
+
+bool ScoreStore::replaceAll(std::vector<LeaderboardEntry> entries) {
+    uint32_t order = 0;
+    for (LeaderboardEntry& entry : entries) {
+        entry.key = (entry.key & ~uint64_t(UINT32_MAX)) | order++;
+    }
+
+    recent.clear();
+    sortedCount = 0;
+    nextOrder = order;
+    if (!opened) {
+        recent.buildKeyed(std::move(entries));
+        return true;
+    }
+
+    // Nothing may still be writing to the old file
+    writer.flush();
+    file.close();
+    writer.finishCompaction();
+    writer.takeCompacted();
+
+    std::sort(entries.begin(), entries.end(), keyLess);
+    bool written = HighScoreWriter::writeAtomically(path, [&](const HighScoreWriter::FileSink& sink) {
+        unsigned char header[HEADER_SIZE];
+        writeHeader(header, entries.size(), order);
+        if (!sink(header, HEADER_SIZE)) return false;
+
+        RecordWriter records(sink);
+        for (const LeaderboardEntry& entry : entries) {
+            records.add(entry);
+        }
+        return records.finish();
+    });
+
+    if (!written || !mapFile(false)) {
+        printf("Error: Could not save high scores to %s\n", path.c_str());
+        recent.buildKeyed(std::move(entries));
+        return false;
+    }
+    return true;
+}
+
+size_t ScoreStore::countAbove(int score) const {
+    return sortedBefore(Leaderboard::keyOf(score)) + recent.countAbove(score);
+}
+
+void ScoreStore::page(size_t position, size_t count, std::vector<LeaderboardEntry>& out) const {
+    out.clear();
+    if (position >= size()) return;
+
+    // Sorted records before the position: the first whose place in the
+    // merged table (its index plus the recent scores before it) is at or
+    // after the position
+    size_t low = position > recent.size() ? position - recent.size() : 0;
+    size_t high = std::min(position, sortedCount);
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (middle + recent.countBefore(sortedKey(middle)) < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // Merge the two from there
+    size_t sorted = low;
+    std::vector<LeaderboardEntry> newer;
+    recent.page(position - sorted, count, newer);
+    size_t next = 0;
+    while (out.size() < count && (sorted < sortedCount || next < newer.size())) {
+        if (next == newer.size() || (sorted < sortedCount && sortedKey(sorted) < newer[next].key)) {
+            out.push_back(sortedEntry(sorted++));
+        } else {
+            out.push_back(newer[next++]);
+        }
+    }
+}
+
+bool ScoreStore::flush() {
+    bool ok = writer.flush();
+    if (file.isOpen()) takeCompaction(true);
+    return ok;
+}
+
+void ScoreStore::startCompaction() {
+    if (writer.compact(&ScoreStore::rewrite)) {
+        compactedBefore = nextOrder;
+    }
+}
+
+void ScoreStore::takeCompaction(bool moveWaiting) {
+    // Windows can't replace a mapped file
+    const bool unmapped = moveWaiting && writer.isMovePending();
+    if (unmapped) {
+        file.close();
+        writer.finishCompaction();
+    }
+
+    const bool compacted = writer.takeCompacted();
+    if (!compacted && !unmapped) return;
+
+    file.close();
+    if (!mapFile(false)) {
+        printf("Error: Could not reopen high score file %s\n", path.c_str());
+    }
+    if (!compacted) return;
+
+    // The compacted file has every score queued before the compaction
+    std::vector<LeaderboardEntry> newer;
+    recent.forEach(0, recent.size(), [&](const LeaderboardEntry& entry) {
+        if (Leaderboard::orderOf(entry) >= compactedBefore) newer.push_back(entry);
+    });
+    recent.buildKeyed(std::move(newer));
+}
+
+bool ScoreStore::rewrite(const std::string& path, const HighScoreWriter::FileSink& sink) {
+    MappedFile source;
+    size_t sorted = 0;
+    size_t recentCount = 0;
+    uint32_t nextOrder = 0;
+    if (!source.open(path) ||
+        !readHeader(source.getData(), source.getSize(), sorted, recentCount, nextOrder)) {
+        return false;
+    }
+
+    // Sort the recent records, then merge them into the sorted ones in one pass
+    const unsigned char* records = source.getData() + HEADER_SIZE;
+    std::vector<LeaderboardEntry> newer(recentCount);
+    for (size_t i = 0; i < recentCount; ++i) {
+        readRecord(records + (sorted + i) * RECORD_SIZE, newer[i]);
+        nextOrder = std::max(nextOrder, Leaderboard::orderOf(newer[i]) + 1);
+    }
+    std::sort(newer.begin(), newer.end(), keyLess);
+
+    unsigned char header[HEADER_SIZE];
+    writeHeader(header, sorted + recentCount, nextOrder);
+    if (!sink(header, HEADER_SIZE)) return false;
+
+    RecordWriter out(sink);
+    size_t next = 0;
+    for (const LeaderboardEntry& entry : newer) {
+        while (next < sorted && readU64(records + next * RECORD_SIZE) < entry.key) {
+            out.addRaw(records + next++ * RECORD_SIZE);
+        }
+        out.add(entry);
+    }
+    while (next < sorted) {
+        out.addRaw(records + next++ * RECORD_SIZE);
+    }
+    return out.finish();
+}
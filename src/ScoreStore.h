@@ -0,0 +1,111 @@
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "HighScoreWriter.h"
+#include "Leaderboard.h"
+#include "MappedFile.h"
+
+// Every score ever played, kept in the score file (see ScoreFileFormat.h).
+//
+// The sorted part of the file is memory-mapped and searched in place, so
+// opening the file reads only its header and the scores added since it
+// was last compacted: startup takes the same time for ten scores or ten
+// million. Those recent scores live in a Leaderboard in memory, and
+// queries merge the two.
+//
+// New scores are appended to the file in the background (HighScoreWriter).
+// Once COMPACT_AFTER of them have piled up the writer thread rewrites the
+// file with them merged into the sorted part and moves it into place; the
+// next add only maps it again. On Windows the move waits for flush, which
+// unmaps the file first.
+//
+// Until open is called the store is only in memory and nothing is saved.
+class ScoreStore {
+public:
+    explicit ScoreStore(const std::string& path);
+    ~ScoreStore();
+
+    ScoreStore(const ScoreStore&) = delete;
+    ScoreStore& operator=(const ScoreStore&) = delete;
+
+    // Open the file, removing a compaction a crash cut off. A missing
+    // file leaves the table empty and isNew() true; the file is written by
+    // the first replaceAll. A damaged file is moved aside (with a warning)
+    // for an empty table, and false is returned.
+    bool open();
+    void close();
+    bool isNew() const { return created; }
+
+    // Add a score; returns its position (0 = top)
+    size_t add(LeaderboardEntry entry);
+
+    // Add many scores (in the order they were played)
+    void addAll(std::vector<LeaderboardEntry> entries);
+
+    // Replace every score with these, writing the file now
+    bool replaceAll(std::vector<LeaderboardEntry> entries);
+
+    size_t size() const { return sortedCount + recent.size(); }
+
+    // Scores higher than a score
+    size_t countAbove(int score) const;
+
+    // Copy up to count entries from a position (0 = top) into out
+    void page(size_t position, size_t count, std::vector<LeaderboardEntry>& out) const;
+
+    // Call fn(entry) for every entry, best first
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        std::vector<LeaderboardEntry> chunk;
+        for (size_t position = 0; position < size(); position += chunk.size()) {
+            page(position, FOREACH_CHUNK, chunk);
+            for (const LeaderboardEntry& entry : chunk) fn(entry);
+        }
+    }
+
+    // Wait for queued writes (and move a waiting compaction into place);
+    // false if a write failed
+    bool flush();
+
+    // Scores kept in memory before the file is compacted
+    static constexpr size_t COMPACT_AFTER = 4096;
+
+private:
+    static constexpr size_t FOREACH_CHUNK = 4096;
+
+    // Key of the nth sorted record in the mapping
+    uint64_t sortedKey(size_t index) const;
+    LeaderboardEntry sortedEntry(size_t index) const;
+
+    // Sorted records that sort before a key
+    size_t sortedBefore(uint64_t key) const;
+
+    // Map the file and check its header; recent scores are read if wanted
+    bool mapFile(bool readRecent);
+
+    // Queue a compaction of the file
+    void startCompaction();
+
+    // Map the file again if a compaction was moved into place, first
+    // unmapping it for one waiting to be moved if moveWaiting
+    void takeCompaction(bool moveWaiting);
+
+    // Write the compacted contents of a score file (on the writer thread)
+    static bool rewrite(const std::string& path, const HighScoreWriter::FileSink& sink);
+
+    std::string path;
+    MappedFile file;
+    size_t sortedCount;        // Records in the sorted part of the mapping
+    Leaderboard recent;        // Scores not in the sorted part
+    uint32_t nextOrder;        // Order stamped on the next score
+    uint32_t compactedBefore;  // Orders the queued compaction covers
+    bool opened;
+    bool created;
+    HighScoreWriter writer;
+};
+
+#endif // SCORESTORE_H
@@ -0,0 +1,184 @@
+#include "Skin.h"
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+#include "AssetPack.h"
+#include "Constants.h"
+
+#ifdef HAVE_SDL2_IMAGE
+#include <SDL2/SDL_image.h>
+#endif
+
+namespace {
+
+// File names (without extension) of the pictures a skin folder holds
+const char* const SPRITE_FILES[] = {"head", "body", "corner", "tail", "food"};
+constexpr int FILE_COUNT = 5;
+
+// Empty pixels between packed sprites so filtering never bleeds across
+constexpr int PADDING = 2;
+
+// Size of the white block behind SkinSprite::SOLID
+constexpr int SOLID_SIZE = 4;
+
+// Load one picture as ARGB8888; PNG needs SDL2_image, BMP always works
+SDL_Surface* loadSprite(const std::string& base) {
+    SDL_Surface* surface = nullptr;
+#ifdef HAVE_SDL2_IMAGE
+    if (SDL_RWops* rw = openAsset(base + ".png")) {
+        surface = IMG_Load_RW(rw, 1);
+    }
+#endif
+    if (!surface) {
+        if (SDL_RWops* rw = openAsset(base + ".bmp")) {
+            surface = SDL_LoadBMP_RW(rw, 1);
+        }
+    }
+    if (!surface) return nullptr;
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+    return converted;
+}
+
+} // namespace
+
+SkinLoader::SkinLoader()
+    : loaded(nullptr) {
+}
+
+SkinLoader::~SkinLoader() {
+    shutdown();
+}
+
+void SkinLoader::load(const std::string& name) {
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    worker = std::thread([this, name] {
+        SkinImage* image = loadImage(name);
+        if (!image) return;
+
+        // Replace a finished skin nobody has taken yet
+        delete loaded.exchange(image, std::memory_order_acq_rel);
+    });
+}
+
+SkinImage* SkinLoader::takeLoaded() {
+    // Cheap check first: this runs every frame
+    if (!loaded.load(std::memory_order_relaxed)) return nullptr;
+    return loaded.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void SkinLoader::shutdown() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    delete loaded.exchange(nullptr);
+}
+
+SkinImage* SkinLoader::loadImage(const std::string& name) {
+    std::string dir = std::string(Constants::SKIN_DIR) + name + "/";
+
+    SDL_Surface* sprites[FILE_COUNT] = {};
+    bool complete = true;
+    for (int i = 0; i < FILE_COUNT; ++i) {
+        sprites[i] = loadSprite(dir + SPRITE_FILES[i]);
+        if (!sprites[i]) {
+            printf("Warning: Skin '%s' has no usable %s image in %s\n",
+                   name.c_str(), SPRITE_FILES[i], dir.c_str());
+            complete = false;
+            break;
+        }
+    }
+
+    SkinImage* image = nullptr;
+    if (complete) {
+        // One row: the sprites, then the solid block
+        int atlasWidth = SOLID_SIZE;
+        int atlasHeight = SOLID_SIZE;
+        for (SDL_Surface* sprite : sprites) {
+            atlasWidth += sprite->w + PADDING;
+            atlasHeight = std::max(atlasHeight, sprite->h);
+        }
+
+        SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32,
+                                                            SDL_PIXELFORMAT_ARGB8888);
+        if (atlas) {
+            image = new SkinImage();
+            image->name = name;
+            image->atlas = atlas;
+            SDL_FillRect(atlas, nullptr, 0);
+
+            const float w = static_cast<float>(atlasWidth);
+            const float h = static_cast<float>(atlasHeight);
+            int penX = 0;
+            for (int i = 0; i < FILE_COUNT; ++i) {
+                // Copy alpha as is instead of blending onto the empty atlas
+                SDL_SetSurfaceBlendMode(sprites[i], SDL_BLENDMODE_NONE);
+                SDL_Rect dest = {penX, 0, sprites[i]->w, sprites[i]->h};
+                SDL_BlitSurface(sprites[i], nullptr, atlas, &dest);
+
+                image->uv[i] = {penX / w, 0.0f, sprites[i]->w / w, sprites[i]->h / h};
+                penX += sprites[i]->w + PADDING;
+            }
+
+            // Sample the middle of the white block so edges never blend in
+            SDL_Rect solid = {penX, 0, SOLID_SIZE, SOLID_SIZE};
+            SDL_FillRect(atlas, &solid, 0xFFFFFFFF);
+            image->uv[static_cast<int>(SkinSprite::SOLID)] = {
+                (penX + 1) / w, 1.0f / h, (SOLID_SIZE - 2) / w, (SOLID_SIZE - 2) / h
+            };
+        } else {
+            printf("Warning: Could not pack skin '%s': %s\n", name.c_str(), SDL_GetError());
+        }
+    }
+
+    for (SDL_Surface* sprite : sprites) {
+        if (sprite) SDL_FreeSurface(sprite);
+    }
+    return image;
+}
+
+Skin::Skin()
+    : backend(nullptr)
+    , texture(nullptr)
+    , uv() {
+}
+
+Skin::~Skin() {
+    destroy();
+}
+
+bool Skin::create(RenderBackend& backend, const SkinImage& image) {
+    destroy();
+    if (!image.atlas) return false;
+
+    texture = backend.createTextureFromSurface(image.atlas);
+    if (!texture) {
+        printf("Warning: Could not create skin texture: %s\n", SDL_GetError());
+        return false;
+    }
+
+    this->backend = &backend;
+    backend.setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    std::copy(image.uv, image.uv + SKIN_SPRITE_COUNT, uv);
+    name = image.name;
+    return true;
+}
+
+void Skin::destroy() {
+    if (texture) {
+        backend->destroyTexture(texture);
+        texture = nullptr;
+    }
+    name.clear();
+}
+
+void Skin::swap(Skin& other) {
+    std::swap(backend, other.backend);
+    std::swap(texture, other.texture);
+    std::swap(uv, other.uv);
+    std::swap(name, other.name);
+}
@@ -0,0 +1,91 @@
+#ifndef SKIN_H
+#define SKIN_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "RenderBackend.h"
+
+// Pictures in a skin. Each is drawn in one orientation and rotated in
+// quarter turns when drawn:
+//   HEAD   facing up
+//   BODY   running from the top edge to the bottom edge
+//   CORNER joining the top edge to the right edge
+//   TAIL   joined to the segment above it
+//   FOOD   (never rotated)
+// SOLID is a white block added when packing, so plain colored quads can
+// be drawn from the same texture.
+enum class SkinSprite : int { HEAD, BODY, CORNER, TAIL, FOOD, SOLID };
+constexpr int SKIN_SPRITE_COUNT = 6;
+
+// A skin packed into one image, ready to upload (built off the game thread)
+struct SkinImage {
+    std::string name;
+    SDL_Surface* atlas;
+    SDL_FRect uv[SKIN_SPRITE_COUNT]; // Normalized, per SkinSprite
+
+    SkinImage() : atlas(nullptr), uv() {}
+    ~SkinImage() {
+        if (atlas) SDL_FreeSurface(atlas);
+    }
+
+    SkinImage(const SkinImage&) = delete;
+    SkinImage& operator=(const SkinImage&) = delete;
+};
+
+// Loads and packs skins on a background thread. A finished skin is
+// published with one atomic pointer swap, so the game thread picks up
+// either the whole new skin or nothing.
+class SkinLoader {
+public:
+    SkinLoader();
+    ~SkinLoader();
+
+    // Start loading Constants::SKIN_DIR + name. Waits for a previous load
+    // still in progress to finish first.
+    void load(const std::string& name);
+
+    // Finished skin not yet taken, or nullptr. The caller owns the result.
+    SkinImage* takeLoaded();
+
+    // Wait for the loader thread and discard anything not taken
+    void shutdown();
+
+    // Read and pack every picture of a skin; nullptr if one is missing
+    static SkinImage* loadImage(const std::string& name);
+
+private:
+    std::thread worker;
+    std::atomic<SkinImage*> loaded;
+};
+
+// A skin uploaded to the backend: one texture holding every sprite
+class Skin {
+public:
+    Skin();
+    ~Skin();
+
+    Skin(const Skin&) = delete;
+    Skin& operator=(const Skin&) = delete;
+
+    // Upload a packed skin
+    bool create(RenderBackend& backend, const SkinImage& image);
+    void destroy();
+
+    // Exchange contents with another skin (used to swap in a new one)
+    void swap(Skin& other);
+
+    bool isReady() const { return texture != nullptr; }
+    const std::string& getName() const { return name; }
+    RenderTexture* getTexture() const { return texture; }
+    const SDL_FRect& getUV(SkinSprite sprite) const { return uv[static_cast<int>(sprite)]; }
+
+private:
+    RenderBackend* backend;
+    RenderTexture* texture;
+    SDL_FRect uv[SKIN_SPRITE_COUNT];
+    std::string name;
+};
+
+#endif // SKIN_H
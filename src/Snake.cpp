@@ -1,6 +1,16 @@
 #include "Snake.h"
+#include <cstddef>
 
-Snake::Snake() {
+namespace {
+// Shared by all snakes so two bodies never report the same generation
+uint32_t generationCounter = 0;
+}
+
+Snake::Snake()
+    : stepCount(0)
+    , generation(0)
+    , arenaWidth(Constants::GRID_WIDTH)
+    , arenaHeight(Constants::GRID_HEIGHT) {
     reset();
 }
 
@@ -8,8 +18,8 @@ void Snake::reset() {
     segments.clear();
 
     // Start in the middle of the grid
-    int startX = Constants::GRID_WIDTH / 2;
-    int startY = Constants::GRID_HEIGHT / 2;
+    int startX = arenaWidth / 2;
+    int startY = arenaHeight / 2;
 
     // Create initial snake (head + body segments going left)
     for (int i = 0; i < Constants::INITIAL_SNAKE_LENGTH; ++i) {
@@ -20,6 +30,23 @@ void Snake::reset() {
     nextDirection = Direction::RIGHT;
     alive = true;
     hasEaten = false;
+    stepCount = 0;
+    generation = ++generationCounter;
+}
+
+void Snake::setSegments(const std::vector<Position>& body, Direction dir) {
+    segments = body;
+    direction = dir;
+    nextDirection = dir;
+    alive = true;
+    hasEaten = false;
+    stepCount = 0;
+    generation = ++generationCounter;
+}
+
+void Snake::setArena(int width, int height) {
+    arenaWidth = width;
+    arenaHeight = height;
 }
 
 void Snake::setDirection(Direction newDir) {
@@ -86,6 +113,8 @@ void Snake::move() {
     } else {
         segments.pop_back();
     }
+
+    stepCount++;
 }
 
 void Snake::grow() {
@@ -96,8 +125,8 @@ bool Snake::checkWallCollision() const {
     if (segments.empty()) return false;
 
     const Position& head = segments.front();
-    return (head.x < 0 || head.x >= Constants::GRID_WIDTH ||
-            head.y < 0 || head.y >= Constants::GRID_HEIGHT);
+    return (head.x < 0 || head.x >= arenaWidth ||
+            head.y < 0 || head.y >= arenaHeight);
 }
 
 bool Snake::checkSelfCollision() const {
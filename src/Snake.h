@@ -25,6 +25,16 @@ public:
     void grow();
     void setDirection(Direction newDir);
 
+    // Replace the whole body (head first), e.g. to set up benchmark scenes
+    void setSegments(const std::vector<Position>& body, Direction dir);
+
+    // Board size in cells (GRID_WIDTH x GRID_HEIGHT unless changed). Takes
+    // effect for wall collisions at once and for the start position on
+    // the next reset().
+    void setArena(int width, int height);
+    int getArenaWidth() const { return arenaWidth; }
+    int getArenaHeight() const { return arenaHeight; }
+
     // Collision detection
     bool checkWallCollision() const;
     bool checkSelfCollision() const;
@@ -32,11 +42,17 @@ public:
 
     // Getters
     const Position& getHead() const { return segments.front(); }
+    const Position& getTail() const { return segments.back(); }
     const std::vector<Position>& getSegments() const { return segments; }
     Direction getDirection() const { return direction; }
     int getLength() const { return static_cast<int>(segments.size()); }
     bool isAlive() const { return alive; }
 
+    // Change tracking for incremental rendering: the step count goes up by
+    // one per move(), the generation changes whenever the body is replaced
+    uint64_t getStepCount() const { return stepCount; }
+    uint32_t getGeneration() const { return generation; }
+
     // Setters
     void setAlive(bool value) { alive = value; }
 
@@ -46,6 +62,10 @@ private:
     Direction nextDirection; // Buffered direction to prevent 180-degree turns
     bool alive;
     bool hasEaten; // Flag to grow on next move
+    uint64_t stepCount;
+    uint32_t generation;
+    int arenaWidth;
+    int arenaHeight;
 };
 
 #endif // SNAKE_H
@@ -0,0 +1,658 @@
+#include "SoftwareRenderBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Constants.h"
+
+// Vector span fills where the target guarantees them
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SNAKE_SPAN_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SNAKE_SPAN_NEON 1
+#endif
+
+namespace {
+
+// RenderTexture is only ever a SoftwareTexture in this backend
+SoftwareTexture* toSoftware(RenderTexture* texture) {
+    return reinterpret_cast<SoftwareTexture*>(texture);
+}
+
+RenderTexture* fromSoftware(SoftwareTexture* texture) {
+    return reinterpret_cast<RenderTexture*>(texture);
+}
+
+inline Uint32 packColor(SDL_Color color) {
+    return (static_cast<Uint32>(color.a) << 24) | (static_cast<Uint32>(color.r) << 16) |
+           (static_cast<Uint32>(color.g) << 8) | static_cast<Uint32>(color.b);
+}
+
+// round(x / 255) for x in [0, 255 * 255]
+inline Uint32 div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// SDL_BLENDMODE_BLEND: rgb = src * a + dst * (1 - a), alpha = a + dstAlpha * (1 - a).
+// Every channel is a lerp from dst towards src, with the source alpha
+// channel taken as 255.
+inline Uint32 blendPixel(Uint32 dst, Uint32 src, Uint32 alpha) {
+    Uint32 inv = 255 - alpha;
+    Uint32 a = div255(255 * alpha + (dst >> 24) * inv);
+    Uint32 r = div255(((src >> 16) & 0xFF) * alpha + ((dst >> 16) & 0xFF) * inv);
+    Uint32 g = div255(((src >> 8) & 0xFF) * alpha + ((dst >> 8) & 0xFF) * inv);
+    Uint32 b = div255((src & 0xFF) * alpha + (dst & 0xFF) * inv);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// Store one pixel. Every mode other than NONE is treated as BLEND, the
+// only other mode the game uses.
+inline void writePixel(Uint32& dst, Uint32 src, SDL_BlendMode mode) {
+    if (mode == SDL_BLENDMODE_NONE) {
+        dst = src;
+        return;
+    }
+
+    Uint32 alpha = src >> 24;
+    if (alpha == 255) {
+        dst = src;
+    } else if (alpha != 0) {
+        dst = blendPixel(dst, src, alpha);
+    }
+}
+
+// Multiply a texel by a vertex color
+inline Uint32 modulate(Uint32 texel, SDL_Color color) {
+    Uint32 a = div255((texel >> 24) * color.a);
+    Uint32 r = div255(((texel >> 16) & 0xFF) * color.r);
+    Uint32 g = div255(((texel >> 8) & 0xFF) * color.g);
+    Uint32 b = div255((texel & 0xFF) * color.b);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+inline bool isWhite(SDL_Color color) {
+    return color.r == 255 && color.g == 255 && color.b == 255 && color.a == 255;
+}
+
+inline bool sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Set count pixels to one color
+void fillSpan(Uint32* dst, int count, Uint32 color) {
+    int i = 0;
+#if defined(SNAKE_SPAN_SSE2)
+    __m128i fill = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), fill);
+    }
+#elif defined(SNAKE_SPAN_NEON)
+    uint32x4_t fill = vdupq_n_u32(color);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, fill);
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+// Blend one translucent color over count pixels
+void blendSpan(Uint32* dst, int count, Uint32 color) {
+    const Uint32 alpha = color >> 24;
+    const Uint32 inv = 255 - alpha;
+    int i = 0;
+
+#if defined(SNAKE_SPAN_SSE2)
+    // Per 16-bit channel: (src * a + 128 + dst * (255 - a)), then / 255.
+    // The largest intermediate is 255 * 255 + 128, which fits.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color | 0xFF000000u)), zero);
+    const __m128i srcTerm = _mm_add_epi16(
+        _mm_mullo_epi16(src, _mm_set1_epi16(static_cast<short>(alpha))),
+        _mm_set1_epi16(128));
+    const __m128i invAlpha = _mm_set1_epi16(static_cast<short>(inv));
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), invAlpha), srcTerm);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), invAlpha), srcTerm);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(SNAKE_SPAN_NEON)
+    const uint8x8_t src = vreinterpret_u8_u32(vdup_n_u32(color | 0xFF000000u));
+    const uint16x8_t srcTerm = vaddq_u16(vmull_u8(src, vdup_n_u8(static_cast<uint8_t>(alpha))),
+                                         vdupq_n_u16(128));
+    const uint8x8_t invAlpha = vdup_n_u8(static_cast<uint8_t>(inv));
+
+    for (; i + 4 <= count; i += 4) {
+        uint8x16_t pixels = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint16x8_t lo = vmlal_u8(srcTerm, vget_low_u8(pixels), invAlpha);
+        uint16x8_t hi = vmlal_u8(srcTerm, vget_high_u8(pixels), invAlpha);
+        uint8x8_t outLo = vshrn_n_u16(vaddq_u16(lo, vshrq_n_u16(lo, 8)), 8);
+        uint8x8_t outHi = vshrn_n_u16(vaddq_u16(hi, vshrq_n_u16(hi, 8)), 8);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vcombine_u8(outLo, outHi)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        dst[i] = blendPixel(dst[i], color, alpha);
+    }
+}
+
+// Twice the signed area of the triangle (a, b, p)
+inline float edge(const SDL_FPoint& a, const SDL_FPoint& b, float px, float py) {
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+// Top-left fill rule: a pixel center exactly on an edge belongs to only
+// one of the triangles sharing it, so shared diagonals are not blended twice
+inline bool isTopLeft(const SDL_FPoint& a, const SDL_FPoint& b) {
+    return (a.y == b.y && b.x < a.x) || b.y < a.y;
+}
+
+inline int sampleIndex(float coord, int size) {
+    int index = static_cast<int>(std::floor(coord * size));
+    return std::min(std::max(index, 0), size - 1);
+}
+
+} // namespace
+
+SoftwareRenderBackend::SoftwareRenderBackend(bool windowed)
+    : windowed(windowed)
+    , window(nullptr)
+    , frameSurface(nullptr)
+    , screen()
+    , target(&screen)
+    , drawBlendMode(SDL_BLENDMODE_BLEND)
+    , clipRect{0, 0, 0, 0}
+    , clipping(false) {
+    screen.width = 0;
+    screen.height = 0;
+    screen.blendMode = SDL_BLENDMODE_NONE;
+}
+
+SoftwareRenderBackend::~SoftwareRenderBackend() {
+    shutdown();
+}
+
+bool SoftwareRenderBackend::init(int width, int height) {
+    screen.width = width;
+    screen.height = height;
+    screen.pixels.assign(static_cast<size_t>(width) * height, 0);
+    target = &screen;
+
+    if (!windowed) return true;
+
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+        printf("Error: Could not initialize SDL video: %s\n", SDL_GetError());
+        return false;
+    }
+
+    window = SDL_CreateWindow(Constants::WINDOW_TITLE,
+                              SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                              width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+    if (!window) {
+        printf("Error: Could not create window: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetWindowMinimumSize(window, width, height);
+
+    // Wrap the framebuffer (no copy) so present() can blit it
+    frameSurface = SDL_CreateRGBSurfaceWithFormatFrom(screen.pixels.data(), width, height, 32,
+                                                      width * static_cast<int>(sizeof(Uint32)),
+                                                      SDL_PIXELFORMAT_ARGB8888);
+    if (!frameSurface) {
+        printf("Error: Could not wrap software framebuffer: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetSurfaceBlendMode(frameSurface, SDL_BLENDMODE_NONE);
+    return true;
+}
+
+void SoftwareRenderBackend::shutdown() {
+    if (frameSurface) {
+        SDL_FreeSurface(frameSurface);
+        frameSurface = nullptr;
+    }
+
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+
+    screen.pixels.clear();
+    screen.width = screen.height = 0;
+    target = &screen;
+}
+
+void SoftwareRenderBackend::clear(SDL_Color color) {
+    if (!target || target->pixels.empty()) return;
+    fillSpan(target->pixels.data(), static_cast<int>(target->pixels.size()), packColor(color));
+}
+
+void SoftwareRenderBackend::present() {
+    if (!window || !frameSurface) return;
+
+    SDL_Surface* windowSurface = SDL_GetWindowSurface(window);
+    if (!windowSurface) return;
+
+    if (windowSurface->w == screen.width && windowSurface->h == screen.height) {
+        SDL_BlitSurface(frameSurface, nullptr, windowSurface, nullptr);
+    } else {
+        // Enlarge by a whole factor, centered, like the SDL backend
+        int scale = std::max(1, std::min(windowSurface->w / screen.width,
+                                         windowSurface->h / screen.height));
+        SDL_Rect dest = {
+            (windowSurface->w - screen.width * scale) / 2,
+            (windowSurface->h - screen.height * scale) / 2,
+            screen.width * scale,
+            screen.height * scale
+        };
+        SDL_FillRect(windowSurface, nullptr, SDL_MapRGB(windowSurface->format, 0, 0, 0));
+        SDL_BlitScaled(frameSurface, nullptr, windowSurface, &dest);
+    }
+    SDL_UpdateWindowSurface(window);
+}
+
+void SoftwareRenderBackend::setClipRect(const SDL_Rect* rect) {
+    clipping = (rect != nullptr);
+    if (rect) clipRect = *rect;
+}
+
+bool SoftwareRenderBackend::clipToTarget(SDL_Rect& rect) const {
+    if (!target) return false;
+
+    int x0 = std::max(rect.x, 0);
+    int y0 = std::max(rect.y, 0);
+    int x1 = std::min(rect.x + rect.w, target->width);
+    int y1 = std::min(rect.y + rect.h, target->height);
+    if (clipping) {
+        x0 = std::max(x0, clipRect.x);
+        y0 = std::max(y0, clipRect.y);
+        x1 = std::min(x1, clipRect.x + clipRect.w);
+        y1 = std::min(y1, clipRect.y + clipRect.h);
+    }
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    rect = {x0, y0, x1 - x0, y1 - y0};
+    return true;
+}
+
+void SoftwareRenderBackend::fillClipped(const SDL_Rect& rect, SDL_Color color, SDL_BlendMode mode) {
+    bool opaque = (mode == SDL_BLENDMODE_NONE || color.a == 255);
+    if (!opaque && color.a == 0) return;
+
+    Uint32 packed = packColor(color);
+    for (int y = rect.y; y < rect.y + rect.h; ++y) {
+        Uint32* row = &target->pixels[static_cast<size_t>(y) * target->width + rect.x];
+        if (opaque) {
+            fillSpan(row, rect.w, packed);
+        } else {
+            blendSpan(row, rect.w, packed);
+        }
+    }
+}
+
+void SoftwareRenderBackend::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    SDL_Rect clipped = rect;
+    if (clipToTarget(clipped)) {
+        fillClipped(clipped, color, drawBlendMode);
+    }
+}
+
+void SoftwareRenderBackend::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    // Top and bottom rows, then the sides between them
+    fillRect({rect.x, rect.y, rect.w, 1}, color);
+    if (rect.h > 1) fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    if (rect.h > 2) {
+        fillRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+        if (rect.w > 1) fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+    }
+}
+
+void SoftwareRenderBackend::drawLine(int x1, int y1, int x2, int y2, SDL_Color color) {
+    // Horizontal and vertical lines (all the game draws) are spans
+    if (x1 == x2 || y1 == y2) {
+        SDL_Rect rect = {std::min(x1, x2), std::min(y1, y2),
+                         std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1};
+        fillRect(rect, color);
+        return;
+    }
+
+    // Bresenham for anything else
+    Uint32 packed = packColor(color);
+    int dx = std::abs(x2 - x1);
+    int dy = -std::abs(y2 - y1);
+    int stepX = (x1 < x2) ? 1 : -1;
+    int stepY = (y1 < y2) ? 1 : -1;
+    int error = dx + dy;
+
+    while (true) {
+        SDL_Rect pixel = {x1, y1, 1, 1};
+        if (clipToTarget(pixel)) {
+            writePixel(target->pixels[static_cast<size_t>(y1) * target->width + x1],
+                       packed, drawBlendMode);
+        }
+        if (x1 == x2 && y1 == y2) break;
+
+        int doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            x1 += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y1 += stepY;
+        }
+    }
+}
+
+bool SoftwareRenderBackend::drawGeometry(RenderTexture* texture,
+                                         const SDL_Vertex* vertices, int numVertices,
+                                         const int* indices, int numIndices) {
+    if (!target || !vertices) return false;
+
+    const SoftwareTexture* source = toSoftware(texture);
+
+    if (!indices) {
+        for (int i = 0; i + 3 <= numVertices; i += 3) {
+            drawTriangle(source, vertices[i], vertices[i + 1], vertices[i + 2]);
+        }
+        return true;
+    }
+
+    for (int i = 0; i < numIndices; ++i) {
+        if (indices[i] < 0 || indices[i] >= numVertices) return false;
+    }
+
+    int i = 0;
+    for (; i + 6 <= numIndices; i += 6) {
+        const int* quad = indices + i;
+
+        // RenderBatch quads are (0, 1, 2) and (0, 2, 3)
+        if (quad[3] == quad[0] && quad[4] == quad[2]) {
+            const SDL_Vertex* corners[4] = {
+                &vertices[quad[0]], &vertices[quad[1]], &vertices[quad[2]], &vertices[quad[5]]
+            };
+            if (drawQuad(source, corners)) continue;
+        }
+
+        drawTriangle(source, vertices[quad[0]], vertices[quad[1]], vertices[quad[2]]);
+        drawTriangle(source, vertices[quad[3]], vertices[quad[4]], vertices[quad[5]]);
+    }
+    for (; i + 3 <= numIndices; i += 3) {
+        drawTriangle(source, vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]);
+    }
+    return true;
+}
+
+bool SoftwareRenderBackend::drawQuad(const SoftwareTexture* texture, const SDL_Vertex* v[4]) {
+    const SDL_Vertex& a = *v[0];
+    const SDL_Vertex& b = *v[1];
+    const SDL_Vertex& c = *v[2];
+    const SDL_Vertex& d = *v[3];
+
+    // Corners in order around an axis-aligned rectangle, one color
+    if (a.position.y != b.position.y || b.position.x != c.position.x ||
+        c.position.y != d.position.y || d.position.x != a.position.x) {
+        return false;
+    }
+    if (!sameColor(a.color, b.color) || !sameColor(a.color, c.color) ||
+        !sameColor(a.color, d.color)) {
+        return false;
+    }
+    if (texture && (a.tex_coord.y != b.tex_coord.y || b.tex_coord.x != c.tex_coord.x ||
+                    c.tex_coord.y != d.tex_coord.y || d.tex_coord.x != a.tex_coord.x)) {
+        return false;
+    }
+
+    // Pixels whose centers lie inside the rectangle
+    float left = std::min(a.position.x, b.position.x);
+    float right = std::max(a.position.x, b.position.x);
+    float top = std::min(a.position.y, d.position.y);
+    float bottom = std::max(a.position.y, d.position.y);
+    int x0 = static_cast<int>(std::ceil(left - 0.5f));
+    int x1 = static_cast<int>(std::ceil(right - 0.5f));
+    int y0 = static_cast<int>(std::ceil(top - 0.5f));
+    int y1 = static_cast<int>(std::ceil(bottom - 0.5f));
+
+    SDL_Rect rect = {x0, y0, x1 - x0, y1 - y0};
+    if (!clipToTarget(rect)) return true; // Nothing visible
+
+    if (!texture) {
+        fillClipped(rect, a.color, drawBlendMode);
+        return true;
+    }
+
+    // Texture coordinates change linearly across the quad
+    float du = (b.tex_coord.x - a.tex_coord.x) / (b.position.x - a.position.x);
+    float dv = (d.tex_coord.y - a.tex_coord.y) / (d.position.y - a.position.y);
+    bool white = isWhite(a.color);
+
+    for (int y = rect.y; y < rect.y + rect.h; ++y) {
+        float texV = a.tex_coord.y + (y + 0.5f - a.position.y) * dv;
+        const Uint32* texRow = &texture->pixels[static_cast<size_t>(sampleIndex(texV, texture->height)) *
+                                                texture->width];
+        Uint32* row = &target->pixels[static_cast<size_t>(y) * target->width];
+
+        for (int x = rect.x; x < rect.x + rect.w; ++x) {
+            float texU = a.tex_coord.x + (x + 0.5f - a.position.x) * du;
+            Uint32 texel = texRow[sampleIndex(texU, texture->width)];
+            if (!white) texel = modulate(texel, a.color);
+            writePixel(row[x], texel, texture->blendMode);
+        }
+    }
+    return true;
+}
+
+void SoftwareRenderBackend::drawTriangle(const SoftwareTexture* texture,
+                                         const SDL_Vertex& a, const SDL_Vertex& b,
+                                         const SDL_Vertex& c) {
+    // Wind consistently so inside means all edge functions positive
+    const SDL_Vertex* v0 = &a;
+    const SDL_Vertex* v1 = &b;
+    const SDL_Vertex* v2 = &c;
+    float area = edge(v0->position, v1->position, v2->position.x, v2->position.y);
+    if (area == 0.0f) return;
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    const SDL_FPoint& p0 = v0->position;
+    const SDL_FPoint& p1 = v1->position;
+    const SDL_FPoint& p2 = v2->position;
+
+    SDL_Rect bounds;
+    bounds.x = static_cast<int>(std::floor(std::min({p0.x, p1.x, p2.x})));
+    bounds.y = static_cast<int>(std::floor(std::min({p0.y, p1.y, p2.y})));
+    bounds.w = static_cast<int>(std::ceil(std::max({p0.x, p1.x, p2.x}))) - bounds.x + 1;
+    bounds.h = static_cast<int>(std::ceil(std::max({p0.y, p1.y, p2.y}))) - bounds.y + 1;
+    if (!clipToTarget(bounds)) return;
+
+    bool topLeft0 = isTopLeft(p1, p2);
+    bool topLeft1 = isTopLeft(p2, p0);
+    bool topLeft2 = isTopLeft(p0, p1);
+    SDL_BlendMode mode = texture ? texture->blendMode : drawBlendMode;
+
+    for (int y = bounds.y; y < bounds.y + bounds.h; ++y) {
+        float py = y + 0.5f;
+        Uint32* row = &target->pixels[static_cast<size_t>(y) * target->width];
+
+        for (int x = bounds.x; x < bounds.x + bounds.w; ++x) {
+            float px = x + 0.5f;
+            float w0 = edge(p1, p2, px, py);
+            float w1 = edge(p2, p0, px, py);
+            float w2 = edge(p0, p1, px, py);
+
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+            if ((w0 == 0.0f && !topLeft0) || (w1 == 0.0f && !topLeft1) ||
+                (w2 == 0.0f && !topLeft2)) {
+                continue;
+            }
+
+            // Barycentric interpolation of color and texture coordinates
+            float l0 = w0 / area;
+            float l1 = w1 / area;
+            float l2 = w2 / area;
+            SDL_Color color = {
+                static_cast<Uint8>(v0->color.r * l0 + v1->color.r * l1 + v2->color.r * l2 + 0.5f),
+                static_cast<Uint8>(v0->color.g * l0 + v1->color.g * l1 + v2->color.g * l2 + 0.5f),
+                static_cast<Uint8>(v0->color.b * l0 + v1->color.b * l1 + v2->color.b * l2 + 0.5f),
+                static_cast<Uint8>(v0->color.a * l0 + v1->color.a * l1 + v2->color.a * l2 + 0.5f)
+            };
+
+            Uint32 src = packColor(color);
+            if (texture) {
+                float u = v0->tex_coord.x * l0 + v1->tex_coord.x * l1 + v2->tex_coord.x * l2;
+                float v = v0->tex_coord.y * l0 + v1->tex_coord.y * l1 + v2->tex_coord.y * l2;
+                Uint32 texel = texture->pixels[static_cast<size_t>(sampleIndex(v, texture->height)) *
+                                               texture->width + sampleIndex(u, texture->width)];
+                src = modulate(texel, color);
+            }
+            writePixel(row[x], src, mode);
+        }
+    }
+}
+
+void SoftwareRenderBackend::copy(RenderTexture* texture, const SDL_Rect* src, const SDL_Rect* dest) {
+    const SoftwareTexture* source = toSoftware(texture);
+    if (!source || !target || source->pixels.empty()) return;
+
+    SDL_Rect from = src ? *src : SDL_Rect{0, 0, source->width, source->height};
+    SDL_Rect to = dest ? *dest : SDL_Rect{0, 0, target->width, target->height};
+    if (from.w <= 0 || from.h <= 0 || to.w <= 0 || to.h <= 0) return;
+
+    SDL_Rect clipped = to;
+    if (!clipToTarget(clipped)) return;
+
+    bool unscaled = (from.w == to.w && from.h == to.h);
+    bool inBounds = from.x >= 0 && from.y >= 0 &&
+                    from.x + from.w <= source->width && from.y + from.h <= source->height;
+
+    // Source column for each destination pixel center, in 16.16 fixed point
+    const Sint64 stepX = (static_cast<Sint64>(from.w) << 16) / to.w;
+    const Sint64 startX = ((static_cast<Sint64>(2 * (clipped.x - to.x) + 1) * from.w) << 16) /
+                          (2 * to.w);
+
+    for (int y = clipped.y; y < clipped.y + clipped.h; ++y) {
+        int sy = from.y + static_cast<int>((static_cast<Sint64>(2 * (y - to.y) + 1) * from.h) /
+                                           (2 * to.h));
+        sy = std::min(std::max(sy, 0), source->height - 1);
+        const Uint32* in = &source->pixels[static_cast<size_t>(sy) * source->width];
+        Uint32* out = &target->pixels[static_cast<size_t>(y) * target->width + clipped.x];
+
+        if (unscaled && inBounds && source->blendMode == SDL_BLENDMODE_NONE) {
+            memcpy(out, in + from.x + (clipped.x - to.x), clipped.w * sizeof(Uint32));
+            continue;
+        }
+
+        Sint64 fx = startX;
+        for (int i = 0; i < clipped.w; ++i, fx += stepX) {
+            int sx = std::min(std::max(from.x + static_cast<int>(fx >> 16), 0), source->width - 1);
+            writePixel(out[i], in[sx], source->blendMode);
+        }
+    }
+}
+
+RenderTexture* SoftwareRenderBackend::createTexture(int width, int height, TextureAccess access) {
+    (void)access; // Every software texture can be streamed to and drawn into
+    if (width <= 0 || height <= 0) return nullptr;
+
+    SoftwareTexture* texture = new SoftwareTexture();
+    texture->width = width;
+    texture->height = height;
+    texture->pixels.assign(static_cast<size_t>(width) * height, 0);
+    texture->blendMode = SDL_BLENDMODE_NONE;
+    return fromSoftware(texture);
+}
+
+RenderTexture* SoftwareRenderBackend::createTextureFromSurface(SDL_Surface* surface) {
+    if (!surface) return nullptr;
+
+    // Converting also turns a color key into transparent pixels
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!converted) return nullptr;
+
+    RenderTexture* texture = createTexture(converted->w, converted->h, TextureAccess::STATIC);
+    if (texture) {
+        SDL_LockSurface(converted);
+        updateTexture(texture, nullptr, converted->pixels, converted->pitch);
+        SDL_UnlockSurface(converted);
+
+        // Same default as SDL_CreateTextureFromSurface
+        bool hasAlpha = surface->format->Amask != 0 || SDL_HasColorKey(surface);
+        toSoftware(texture)->blendMode = hasAlpha ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE;
+    }
+
+    SDL_FreeSurface(converted);
+    return texture;
+}
+
+void SoftwareRenderBackend::destroyTexture(RenderTexture* texture) {
+    SoftwareTexture* software = toSoftware(texture);
+    if (!software) return;
+    if (target == software) target = &screen;
+    delete software;
+}
+
+bool SoftwareRenderBackend::updateTexture(RenderTexture* texture, const SDL_Rect* rect,
+                                          const void* pixels, int pitch) {
+    SoftwareTexture* software = toSoftware(texture);
+    if (!software || !pixels) return false;
+
+    SDL_Rect area = rect ? *rect : SDL_Rect{0, 0, software->width, software->height};
+    if (area.x < 0 || area.y < 0 || area.w < 0 || area.h < 0 ||
+        area.x + area.w > software->width || area.y + area.h > software->height) {
+        return false;
+    }
+
+    const Uint8* in = static_cast<const Uint8*>(pixels);
+    for (int y = 0; y < area.h; ++y) {
+        memcpy(&software->pixels[static_cast<size_t>(area.y + y) * software->width + area.x],
+               in + static_cast<size_t>(y) * pitch, area.w * sizeof(Uint32));
+    }
+    return true;
+}
+
+void SoftwareRenderBackend::setTextureBlendMode(RenderTexture* texture, SDL_BlendMode mode) {
+    SoftwareTexture* software = toSoftware(texture);
+    if (software) software->blendMode = mode;
+}
+
+bool SoftwareRenderBackend::setRenderTarget(RenderTexture* texture) {
+    target = texture ? toSoftware(texture) : &screen;
+    return true;
+}
+
+RenderTexture* SoftwareRenderBackend::getRenderTarget() const {
+    return (target == &screen) ? nullptr : fromSoftware(target);
+}
+
+bool SoftwareRenderBackend::readPixels(const SDL_Rect* rect, void* pixels, int pitch) {
+    if (!target || !pixels) return false;
+
+    // The clip rectangle only limits drawing, so check the bounds here
+    SDL_Rect area = rect ? *rect : SDL_Rect{0, 0, target->width, target->height};
+    if (area.x < 0 || area.y < 0 || area.w <= 0 || area.h <= 0 ||
+        area.x + area.w > target->width || area.y + area.h > target->height) {
+        return false;
+    }
+
+    Uint8* out = static_cast<Uint8*>(pixels);
+    for (int y = 0; y < area.h; ++y) {
+        memcpy(out + static_cast<size_t>(y) * pitch,
+               &target->pixels[static_cast<size_t>(area.y + y) * target->width + area.x],
+               area.w * sizeof(Uint32));
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef SOFTWARERENDERBACKEND_H
+#define SOFTWARERENDERBACKEND_H
+
+#include <vector>
+#include "RenderBackend.h"
+
+// Pixels of a software texture, or of the output framebuffer
+struct SoftwareTexture {
+    int width;
+    int height;
+    std::vector<Uint32> pixels; // ARGB8888, row pitch = width
+    SDL_BlendMode blendMode;
+};
+
+// Rasterizes on the CPU into a memory framebuffer: no GPU, display or
+// video driver is needed. Solid spans are filled and blended four pixels at
+// a time with SSE2 (x86) or NEON (ARM) when the compiler targets them.
+// Geometry is drawn with a fast path for axis-aligned quads (everything
+// RenderBatch produces) and a general triangle rasterizer otherwise;
+// textures are always sampled nearest-neighbour.
+//
+// When windowed, present() copies the framebuffer to a window surface so
+// the game can be played without hardware acceleration.
+class SoftwareRenderBackend : public RenderBackend {
+public:
+    explicit SoftwareRenderBackend(bool windowed = false);
+    ~SoftwareRenderBackend() override;
+
+    bool init(int width, int height) override;
+    void shutdown() override;
+    const char* getName() const override { return "software"; }
+    SDL_Window* getWindow() const override { return window; }
+
+    void clear(SDL_Color color) override;
+    void present() override;
+    void setDrawBlendMode(SDL_BlendMode mode) override { drawBlendMode = mode; }
+    void setClipRect(const SDL_Rect* rect) override;
+
+    void fillRect(const SDL_Rect& rect, SDL_Color color) override;
+    void drawRect(const SDL_Rect& rect, SDL_Color color) override;
+    void drawLine(int x1, int y1, int x2, int y2, SDL_Color color) override;
+    bool drawGeometry(RenderTexture* texture,
+                      const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices) override;
+    void copy(RenderTexture* texture, const SDL_Rect* src, const SDL_Rect* dest) override;
+
+    RenderTexture* createTexture(int width, int height, TextureAccess access) override;
+    RenderTexture* createTextureFromSurface(SDL_Surface* surface) override;
+    void destroyTexture(RenderTexture* texture) override;
+    bool updateTexture(RenderTexture* texture, const SDL_Rect* rect,
+                       const void* pixels, int pitch) override;
+    void setTextureBlendMode(RenderTexture* texture, SDL_BlendMode mode) override;
+    void setTextureScaleMode(RenderTexture*, SDL_ScaleMode) override {}
+
+    bool supportsRenderTargets() const override { return true; }
+    bool setRenderTarget(RenderTexture* texture) override;
+    RenderTexture* getRenderTarget() const override;
+
+    bool readPixels(const SDL_Rect* rect, void* pixels, int pitch) override;
+
+    // The output framebuffer
+    const SoftwareTexture& getFramebuffer() const { return screen; }
+
+private:
+    // Clip a rectangle to the current target and the clip rectangle;
+    // false if nothing is left
+    bool clipToTarget(SDL_Rect& rect) const;
+
+    // Fill or blend a clipped rectangle with one color
+    void fillClipped(const SDL_Rect& rect, SDL_Color color, SDL_BlendMode mode);
+
+    // Draw one quad of the fast path; returns false if it is not an
+    // axis-aligned rectangle with a single color
+    bool drawQuad(const SoftwareTexture* texture, const SDL_Vertex* v[4]);
+
+    // General case: one triangle with interpolated color and coordinates
+    void drawTriangle(const SoftwareTexture* texture,
+                      const SDL_Vertex& a, const SDL_Vertex& b, const SDL_Vertex& c);
+
+    bool windowed;
+    SDL_Window* window;
+    SDL_Surface* frameSurface; // Wraps screen.pixels for blitting to the window
+
+    SoftwareTexture screen;
+    SoftwareTexture* target;
+    SDL_BlendMode drawBlendMode;
+    SDL_Rect clipRect;
+    bool clipping;
+};
+
+#endif // SOFTWARERENDERBACKEND_H
@@ -0,0 +1,56 @@
+#include "StartupTimeline.h"
+#include <algorithm>
+#include <cstdio>
+
+StartupTimeline::StartupTimeline()
+    : origin(now()) {
+}
+
+void StartupTimeline::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    origin = now();
+    steps.clear();
+}
+
+void StartupTimeline::addSpan(const char* name, Uint64 begin) {
+    Uint64 end = now();
+    std::lock_guard<std::mutex> lock(mutex);
+    steps.push_back({name, begin, end, false});
+}
+
+void StartupTimeline::addMark(const char* name) {
+    Uint64 at = now();
+    std::lock_guard<std::mutex> lock(mutex);
+    steps.push_back({name, at, at, true});
+}
+
+double StartupTimeline::elapsedMs() const {
+    return toMs(now());
+}
+
+double StartupTimeline::toMs(Uint64 ticks) const {
+    // Steps timed before start() clamp to zero
+    if (ticks < origin) return 0.0;
+    return static_cast<double>(ticks - origin) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+void StartupTimeline::print() const {
+    std::vector<Step> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted = steps;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Step& a, const Step& b) { return a.begin < b.begin; });
+
+    printf("Startup timeline (ms):\n");
+    for (const Step& step : sorted) {
+        if (step.isMark) {
+            printf("  %-20s %9s %8.1f\n", step.name, "", toMs(step.end));
+        } else {
+            printf("  %-20s %8.1f - %8.1f  (%.1f)\n", step.name, toMs(step.begin),
+                   toMs(step.end), toMs(step.end) - toMs(step.begin));
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <SDL2/SDL.h>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+// When each startup step ran, measured from start(). Steps may be timed
+// on any thread (loading runs on workers); print() lists them in order of
+// starting time, so overlapping loads show up side by side.
+class StartupTimeline {
+public:
+    StartupTimeline();
+
+    // Set time zero and forget earlier steps
+    void start();
+
+    // Record a step that ran from `begin` to now (begin from now())
+    void addSpan(const char* name, Uint64 begin);
+
+    // Record a moment, such as the first frame
+    void addMark(const char* name);
+
+    // Run a task and record how long it took; returns its result
+    template <typename Task>
+    auto time(const char* name, Task task) -> decltype(task()) {
+        Uint64 begin = now();
+        auto result = task();
+        addSpan(name, begin);
+        return result;
+    }
+
+    // Milliseconds since start()
+    double elapsedMs() const;
+
+    // Print every step (call once loading is done)
+    void print() const;
+
+    static Uint64 now() { return SDL_GetPerformanceCounter(); }
+
+private:
+    struct Step {
+        const char* name;
+        Uint64 begin;
+        Uint64 end;
+        bool isMark;
+    };
+
+    double toMs(Uint64 ticks) const;
+
+    Uint64 origin;
+    mutable std::mutex mutex;
+    std::vector<Step> steps;
+};
+
+// True once a background load is done and its result can be taken
+// without waiting
+template <typename T>
+bool isLoadFinished(const std::future<T>& load) {
+    return load.valid() &&
+           load.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+#endif // STARTUPTIMELINE_H
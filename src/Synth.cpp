@@ -0,0 +1,246 @@
+#include "Synth.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Sound effects
+const SynthPatch EAT_BLIP = {SynthWave::SQUARE, 660.0f, 1320.0f, 2.0f, 40.0f, 60.0f, 0.25f};
+const SynthPatch GAME_OVER_FALL = {SynthWave::SAW, 440.0f, 90.0f, 5.0f, 500.0f, 400.0f, 0.3f};
+const SynthPatch GAME_OVER_CRASH = {SynthWave::NOISE, 0.0f, 0.0f, 1.0f, 20.0f, 300.0f, 0.2f};
+
+// Sounds made of several patches are capped per patch
+enum EffectLayer {
+    EAT_LAYER,
+    GAME_OVER_FALL_LAYER,
+    GAME_OVER_CRASH_LAYER
+};
+
+// Instruments of the tune (pitch comes from the notes)
+const SynthPatch BASS = {SynthWave::TRIANGLE, 0.0f, 0.0f, 5.0f, 150.0f, 60.0f, 0.3f};
+const SynthPatch LEAD = {SynthWave::SQUARE, 0.0f, 0.0f, 5.0f, 80.0f, 60.0f, 0.08f};
+const SynthPatch HAT = {SynthWave::NOISE, 0.0f, 0.0f, 1.0f, 5.0f, 30.0f, 0.05f};
+
+// The tune: four bars of sixteenth-note steps over Am - F - C - G.
+// Notes are MIDI numbers (69 = A4).
+const int TEMPO_BPM = 132;
+const int STEPS_PER_BAR = 16;
+const int SONG_STEPS = 4 * STEPS_PER_BAR;
+const int R = -1; // Rest
+
+const int CHORD_ROOTS[] = {45, 41, 48, 43};
+const int BASS_LINE[STEPS_PER_BAR] = {0, R, 0, R, 12, R, 0, R, 0, R, 0, R, 12, R, 7, R};
+const int MELODY[SONG_STEPS] = {
+    69, R, 72, R, 76, R, 72, R, 74, R, 72, R, 69, R, R, R,
+    65, R, 69, R, 72, R, 69, R, 72, R, 74, R, 72, R, R, R,
+    67, R, 72, R, 76, R, 79, R, 76, R, 74, R, 72, R, R, R,
+    71, R, 74, R, 79, R, 74, R, 71, R, 67, R, 69, R, R, R,
+};
+
+int msToFrames(float ms, int rate) {
+    return static_cast<int>(ms * static_cast<float>(rate) / 1000.0f);
+}
+
+// Add one voice's oscillator to the block. The phase is a 32-bit
+// fraction of a cycle, so wrapping around is free.
+template <typename Shape>
+void renderShape(float* out, int frames, Uint32 phase, Uint32 increment, float gain,
+                 float gainStep, Shape shape) {
+    for (int i = 0; i < frames; ++i) {
+        Uint32 p = phase + static_cast<Uint32>(i) * increment;
+        out[i] += shape(p) * (gain + gainStep * static_cast<float>(i));
+    }
+}
+
+float sawAt(Uint32 phase) {
+    return static_cast<float>(static_cast<Sint32>(phase)) * (1.0f / 2147483648.0f);
+}
+
+} // namespace
+
+Synth::Synth()
+    : sampleRate(44100)
+    , effects()
+    , music()
+    , musicPlaying(false)
+    , musicPaused(false)
+    , musicVolume(0.0f)
+    , step(0)
+    , framesToStep(0)
+    , framesPerStep(1)
+    , block() {
+}
+
+void Synth::setSampleRate(int rate) {
+    sampleRate = rate;
+    framesPerStep = rate * 60 / (TEMPO_BPM * 4);
+}
+
+void Synth::startVoice(Voice& voice, const SynthPatch& patch, int note, float volume) {
+    double startHz = patch.startHz;
+    double endHz = patch.endHz;
+    if (note >= 0) {
+        startHz = endHz = 440.0 * std::pow(2.0, (note - 69) / 12.0);
+    }
+
+    voice.patch = &patch;
+    voice.attack = msToFrames(patch.attackMs, sampleRate);
+    voice.hold = msToFrames(patch.holdMs, sampleRate);
+    voice.release = std::max(1, msToFrames(patch.releaseMs, sampleRate));
+    voice.startIncrement = startHz / sampleRate * 4294967296.0;
+    voice.glidePerFrame = startHz > 0.0
+        ? std::log(endHz / startHz) / (voice.attack + voice.hold + voice.release)
+        : 0.0;
+    voice.phase = 0;
+    voice.noise = 0x9E3779B9u;
+    voice.age = 0;
+    voice.volume = volume;
+}
+
+void Synth::playSound(SoundId sound, int volume, const VoiceRules& rules) {
+    const float level = volume / 128.0f;
+
+    auto start = [&](const SynthPatch& patch, EffectLayer layer) {
+        Voice* voice = effects.start(layer, rules, level * patch.gain);
+        if (voice) startVoice(*voice, patch, -1, level);
+    };
+
+    switch (sound) {
+        case SoundId::EAT:
+            start(EAT_BLIP, EAT_LAYER);
+            break;
+        case SoundId::GAME_OVER:
+            start(GAME_OVER_FALL, GAME_OVER_FALL_LAYER);
+            start(GAME_OVER_CRASH, GAME_OVER_CRASH_LAYER);
+            break;
+    }
+}
+
+void Synth::playMusic(int volume) {
+    stopMusic();
+    setMusicVolume(volume);
+    musicPlaying = true;
+}
+
+void Synth::stopMusic() {
+    musicPlaying = false;
+    musicPaused = false;
+    step = 0;
+    framesToStep = 0;
+    for (Voice& voice : music) voice.patch = nullptr;
+}
+
+void Synth::pauseMusic() {
+    musicPaused = true;
+}
+
+void Synth::resumeMusic() {
+    musicPaused = false;
+}
+
+void Synth::setMusicVolume(int volume) {
+    musicVolume = volume / 128.0f;
+}
+
+float Synth::envelopeAt(const Voice& voice, int age) {
+    if (age < voice.attack) return static_cast<float>(age) / voice.attack;
+    age -= voice.attack;
+    if (age < voice.hold) return 1.0f;
+    age -= voice.hold;
+    if (age < voice.release) return 1.0f - static_cast<float>(age) / voice.release;
+    return 0.0f;
+}
+
+bool Synth::renderVoice(Voice& voice, float* out, int frames, float scale) {
+    const SynthPatch& patch = *voice.patch;
+    const float level = voice.volume * patch.gain * scale;
+    const float gain = envelopeAt(voice, voice.age) * level;
+    const float gainStep = (envelopeAt(voice, voice.age + frames) * level - gain) / frames;
+    const Uint32 increment =
+        static_cast<Uint32>(voice.startIncrement * std::exp(voice.glidePerFrame * voice.age));
+
+    switch (patch.wave) {
+        case SynthWave::SQUARE:
+            renderShape(out, frames, voice.phase, increment, gain, gainStep, [](Uint32 p) {
+                return 1.0f - 2.0f * static_cast<float>(static_cast<Sint32>(p >> 31));
+            });
+            break;
+        case SynthWave::SAW:
+            renderShape(out, frames, voice.phase, increment, gain, gainStep, sawAt);
+            break;
+        case SynthWave::TRIANGLE:
+            renderShape(out, frames, voice.phase, increment, gain, gainStep,
+                        [](Uint32 p) { return 2.0f * std::fabs(sawAt(p)) - 1.0f; });
+            break;
+        case SynthWave::NOISE: {
+            // White noise from xorshift; each sample needs the last one
+            Uint32 state = voice.noise;
+            for (int i = 0; i < frames; ++i) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                out[i] += sawAt(state) * (gain + gainStep * static_cast<float>(i));
+            }
+            voice.noise = state;
+            break;
+        }
+    }
+
+    voice.phase += increment * static_cast<Uint32>(frames);
+    voice.age += frames;
+    return voice.age < voice.attack + voice.hold + voice.release;
+}
+
+void Synth::runSequencer() {
+    const int bar = step / STEPS_PER_BAR;
+    const int beat = step % STEPS_PER_BAR;
+
+    if (BASS_LINE[beat] != R) {
+        startVoice(music[0], BASS, CHORD_ROOTS[bar] + BASS_LINE[beat], 1.0f);
+    }
+    if (MELODY[step] != R) {
+        startVoice(music[1], LEAD, MELODY[step], 1.0f);
+    }
+    if (beat % 4 == 2) {
+        startVoice(music[2], HAT, -1, 1.0f);
+    }
+
+    step = (step + 1) % SONG_STEPS;
+    framesToStep = framesPerStep;
+}
+
+void Synth::mix(Sint16* stream, int frames, int channels) {
+    while (frames > 0) {
+        const bool musicRunning = musicPlaying && !musicPaused;
+        if (musicRunning && framesToStep == 0) {
+            runSequencer();
+        }
+
+        if (!musicRunning && effects.isEmpty()) return;
+
+        // Stop each block at the next step so notes start on time
+        int count = std::min(frames, BLOCK_FRAMES);
+        if (musicRunning) count = std::min(count, framesToStep);
+
+        std::fill(block, block + count, 0.0f);
+        effects.update([&](Voice& voice) { return renderVoice(voice, block, count, 1.0f); });
+        if (musicRunning) {
+            for (Voice& voice : music) {
+                if (voice.patch && !renderVoice(voice, block, count, musicVolume)) {
+                    voice.patch = nullptr;
+                }
+            }
+            framesToStep -= count;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int sample = static_cast<int>(block[i] * 32767.0f);
+            for (int c = 0; c < channels; ++c) {
+                int mixed = stream[c] + sample;
+                stream[c] = static_cast<Sint16>(std::min(std::max(mixed, -32768), 32767));
+            }
+            stream += channels;
+        }
+        frames -= count;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <SDL2/SDL.h>
+#include "Constants.h"
+#include "VoicePool.h"
+
+// Oscillator shapes
+enum class SynthWave {
+    SQUARE,
+    SAW,
+    TRIANGLE,
+    NOISE
+};
+
+// One synthesized note: an oscillator gliding from startHz to endHz under
+// an attack / hold / release envelope
+struct SynthPatch {
+    SynthWave wave;
+    float startHz;
+    float endHz;      // Same as startHz for a steady pitch
+    float attackMs;
+    float holdMs;
+    float releaseMs;
+    float gain;       // Peak level, 1.0 = full scale
+};
+
+// A small synthesizer for the game's sound effects and background music,
+// played when the matching file isn't there. It renders straight into the
+// mixer's buffer: nothing to load or decode.
+// Everything but setSampleRate runs on the audio thread.
+//
+// Voices are rendered a block at a time into a float buffer. Within a
+// block each voice's pitch and envelope gain move linearly, so the inner
+// loops are plain arithmetic the compiler vectorizes.
+class Synth {
+public:
+    static constexpr int EFFECT_VOICES = 4;
+    static constexpr int MUSIC_TRACKS = 3;
+    static constexpr int BLOCK_FRAMES = 256;
+
+    Synth();
+
+    // Call before the first mix
+    void setSampleRate(int rate);
+
+    // Start a sound effect (volume 0-128), competing for voices by rules
+    void playSound(SoundId sound, int volume, const VoiceRules& rules);
+
+    // Background music: a looping tune from the built-in sequencer
+    void playMusic(int volume);
+    void stopMusic();
+    void pauseMusic();
+    void resumeMusic();
+    void setMusicVolume(int volume);
+    bool isMusicPlaying() const { return musicPlaying; }
+
+    // Sound effect voices cut short and sounds dropped (any thread)
+    Uint64 getStolenVoices() const { return effects.getStolen(); }
+    Uint64 getDroppedSounds() const { return effects.getDropped(); }
+
+    // Add the next frames of sound into a signed 16-bit buffer
+    void mix(Sint16* stream, int frames, int channels);
+
+private:
+    struct Voice {
+        const SynthPatch* patch; // nullptr when a music voice is free
+        double startIncrement;   // Phase step at the start of the note
+        double glidePerFrame;    // Log of the pitch change per frame
+        Uint32 phase;
+        Uint32 noise;            // Noise generator state
+        int attack;              // Envelope stages, in frames
+        int hold;
+        int release;
+        int age;                 // Frames played
+        float volume;
+    };
+
+    // Start a patch on a voice, at a note's pitch if note >= 0
+    void startVoice(Voice& voice, const SynthPatch& patch, int note, float volume);
+
+    // Add frames of one voice to the block; false once it has ended
+    bool renderVoice(Voice& voice, float* out, int frames, float scale);
+
+    // Move the tune on, starting the notes of each step that begins
+    void runSequencer();
+
+    // Envelope level of a voice after a number of frames
+    static float envelopeAt(const Voice& voice, int age);
+
+    int sampleRate;
+    VoicePool<Voice, EFFECT_VOICES> effects;
+    Voice music[MUSIC_TRACKS];
+
+    // Sequencer
+    bool musicPlaying;
+    bool musicPaused;
+    float musicVolume;
+    int step;
+    int framesToStep;
+    int framesPerStep;
+
+    float block[BLOCK_FRAMES];
+};
+
+#endif // SYNTH_H
@@ -0,0 +1,115 @@
+#include "TextCache.h"
+#include <iterator>
+
+TextCache::TextCache(size_t maxBytes)
+    : backend(nullptr)
+    , maxBytes(maxBytes)
+    , pixelScale(1) {
+}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+Uint32 TextCache::packColor(SDL_Color color) {
+    return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+           (static_cast<Uint32>(color.b) << 8) | color.a;
+}
+
+Uint64 TextCache::hashKey(const std::string& text, int fontSize, Uint32 color) {
+    // FNV-1a over the text, then the size and color
+    Uint64 hash = 14695981039346656037ULL;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= (static_cast<Uint64>(static_cast<Uint32>(fontSize)) << 32) | color;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+RenderTexture* TextCache::find(const std::string& text, int fontSize, SDL_Color color,
+                             int* width, int* height) {
+    Uint32 packed = packColor(color);
+    auto found = index.find(hashKey(text, fontSize, packed));
+
+    if (found == index.end() ||
+        found->second->fontSize != fontSize ||
+        found->second->color != packed ||
+        found->second->text != text) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    // Move to the front (most recently used)
+    entries.splice(entries.begin(), entries, found->second);
+
+    stats.hits++;
+    *width = found->second->width;
+    *height = found->second->height;
+    return found->second->texture;
+}
+
+void TextCache::insert(const std::string& text, int fontSize, SDL_Color color,
+                       RenderTexture* texture, int width, int height) {
+    if (!texture) return;
+
+    Uint32 packed = packColor(color);
+    Uint64 hash = hashKey(text, fontSize, packed);
+
+    // Replace any entry with the same hash (a re-insert or a collision)
+    auto existing = index.find(hash);
+    if (existing != index.end()) {
+        erase(existing->second);
+    }
+
+    Entry entry;
+    entry.hash = hash;
+    entry.text = text;
+    entry.fontSize = fontSize;
+    entry.color = packed;
+    entry.texture = texture;
+    entry.width = width;
+    entry.height = height;
+    entry.bytes = static_cast<size_t>(width) * height * 4 * pixelScale * pixelScale;
+
+    entries.push_front(entry);
+    index[hash] = entries.begin();
+    stats.bytes += entry.bytes;
+    stats.entries = entries.size();
+
+    evict();
+}
+
+void TextCache::evict() {
+    // Never evict the entry just inserted at the front
+    size_t limit = maxBytes * pixelScale * pixelScale;
+    while (stats.bytes > limit && entries.size() > 1) {
+        erase(std::prev(entries.end()));
+        stats.evictions++;
+    }
+}
+
+void TextCache::erase(std::list<Entry>::iterator it) {
+    if (backend) backend->destroyTexture(it->texture);
+    stats.bytes -= it->bytes;
+    index.erase(it->hash);
+    entries.erase(it);
+    stats.entries = entries.size();
+}
+
+void TextCache::clear() {
+    for (Entry& entry : entries) {
+        if (backend) backend->destroyTexture(entry.texture);
+    }
+    entries.clear();
+    index.clear();
+    stats.bytes = 0;
+    stats.entries = 0;
+}
+
+void TextCache::resetCounters() {
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "Constants.h"
+#include "RenderBackend.h"
+
+// Hit/miss counters for the text cache
+struct TextCacheStats {
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+    size_t bytes;    // Estimated texture memory in use
+    size_t entries;
+
+    TextCacheStats() : hits(0), misses(0), evictions(0), bytes(0), entries(0) {}
+};
+
+// Least-recently-used cache of rendered strings, keyed by
+// (text, font size, color). A cached label costs one texture copy;
+// changing text (such as the score) only misses when its value changes.
+// Texture memory is capped; the oldest entries are evicted first.
+class TextCache {
+public:
+    explicit TextCache(size_t maxBytes = Constants::TEXT_CACHE_MAX_BYTES);
+    ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // Backend that owns the cached textures. clear() the cache before the
+    // backend is shut down or replaced.
+    void setBackend(RenderBackend* owner) { backend = owner; }
+
+    // Textures are created this many times their drawn width and height
+    // (see Renderer pixel scale). Memory is counted at that size and the
+    // cap grows with it, so the same strings stay cached at any scale.
+    // clear() the cache before changing it.
+    void setPixelScale(int scale) { pixelScale = scale; }
+
+    // Look up a string; returns nullptr on a miss. Hits become most recent.
+    RenderTexture* find(const std::string& text, int fontSize, SDL_Color color,
+                      int* width, int* height);
+
+    // Add a rendered string. The cache takes ownership of the texture.
+    void insert(const std::string& text, int fontSize, SDL_Color color,
+                RenderTexture* texture, int width, int height);
+
+    // Destroy all cached textures (e.g. when the renderer is recreated)
+    void clear();
+
+    const TextCacheStats& getStats() const { return stats; }
+    void resetCounters();
+
+private:
+    struct Entry {
+        Uint64 hash;
+        std::string text;
+        int fontSize;
+        Uint32 color;
+        RenderTexture* texture;
+        int width;
+        int height;
+        size_t bytes;
+    };
+
+    // Hash of the full key; the lookup never allocates
+    static Uint64 hashKey(const std::string& text, int fontSize, Uint32 color);
+    static Uint32 packColor(SDL_Color color);
+
+    // Drop the least recently used entries until under the memory cap
+    void evict();
+    void erase(std::list<Entry>::iterator it);
+
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<Uint64, std::list<Entry>::iterator> index;
+    RenderBackend* backend;
+    size_t maxBytes; // At a pixel scale of 1
+    int pixelScale;
+    TextCacheStats stats;
+};
+
+#endif // TEXTCACHE_H
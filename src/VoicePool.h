@@ -0,0 +1,140 @@
+#ifndef VOICEPOOL_H
+#define VOICEPOOL_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+// How a sound competes for voices
+struct VoiceRules {
+    int priority;  // Higher wins when voices run out
+    int maxVoices; // Copies of the sound that may play at once
+};
+
+// A fixed set of preallocated voices and the rules for handing them out.
+// The owner fills in and renders the Voice values; the pool decides which
+// voice a new sound gets:
+//
+//   - at its cap, a sound replaces its own quietest (then oldest) copy
+//   - otherwise it takes a free voice if there is one
+//   - otherwise it steals the quietest, then oldest, voice of the lowest
+//     priority playing, as long as that is no higher than its own
+//   - and if every voice is more important, the new sound is dropped
+//
+// Nothing allocates after construction, and mixing never touches more
+// than Capacity voices however often sounds are started. Use it from one
+// thread; only the counters may be read from others.
+template <typename Voice, int Capacity>
+class VoicePool {
+    static_assert(Capacity > 0, "VoicePool needs at least one voice");
+
+public:
+    VoicePool() : slots(), nextOrder(0), stolen(0), dropped(0) {}
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    // Claim a voice for a new copy of a sound (any id the owner likes; the
+    // cap counts voices with the same id). Loudness only ranks voices for
+    // stealing. Returns nullptr if the sound is dropped.
+    Voice* start(int sound, const VoiceRules& rules, float loudness) {
+        Slot* freeSlot = nullptr;
+        Slot* ownVictim = nullptr;
+        Slot* victim = nullptr;
+        int copies = 0;
+
+        for (Slot& slot : slots) {
+            if (!slot.active) {
+                if (!freeSlot) freeSlot = &slot;
+                continue;
+            }
+            if (slot.sound == sound) {
+                ++copies;
+                ownVictim = pickVictim(ownVictim, &slot);
+            }
+            if (slot.priority <= rules.priority) {
+                victim = pickVictim(victim, &slot);
+            }
+        }
+
+        Slot* chosen = freeSlot;
+        if (copies >= rules.maxVoices && ownVictim) {
+            chosen = ownVictim;
+        } else if (!chosen) {
+            chosen = victim;
+        }
+
+        if (!chosen) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (chosen->active) {
+            stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        chosen->active = true;
+        chosen->sound = sound;
+        chosen->priority = rules.priority;
+        chosen->loudness = loudness;
+        chosen->order = nextOrder++;
+        return &chosen->voice;
+    }
+
+    // Call fn(voice) for every playing voice; fn returns false once the
+    // voice's sound has ended, which frees it
+    template <typename Fn>
+    void update(Fn fn) {
+        for (Slot& slot : slots) {
+            if (slot.active && !fn(slot.voice)) {
+                slot.active = false;
+            }
+        }
+    }
+
+    // Silence every voice
+    void clear() {
+        for (Slot& slot : slots) slot.active = false;
+    }
+
+    bool isEmpty() const {
+        for (const Slot& slot : slots) {
+            if (slot.active) return false;
+        }
+        return true;
+    }
+
+    // Sounds that cut another one short, and sounds never played
+    Uint64 getStolen() const { return stolen.load(std::memory_order_relaxed); }
+    Uint64 getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    static constexpr int capacity() { return Capacity; }
+
+private:
+    struct Slot {
+        Voice voice;
+        bool active;
+        int sound;
+        int priority;
+        float loudness;
+        Uint64 order; // Start order; lower is older
+    };
+
+    // The better of two voices to cut short: lower priority, then
+    // quieter, then older
+    static Slot* pickVictim(Slot* best, Slot* candidate) {
+        if (!best) return candidate;
+        if (candidate->priority != best->priority) {
+            return candidate->priority < best->priority ? candidate : best;
+        }
+        if (candidate->loudness != best->loudness) {
+            return candidate->loudness < best->loudness ? candidate : best;
+        }
+        return candidate->order < best->order ? candidate : best;
+    }
+
+    Slot slots[Capacity];
+    Uint64 nextOrder;
+    std::atomic<Uint64> stolen;
+    std::atomic<Uint64> dropped;
+};
+
+#endif // VOICEPOOL_H
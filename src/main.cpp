@@ -2,11 +2,35 @@
 #include <cstdio>
 #include <memory>
 #include "Game.h"
+#include "HighScoreManager.h"
+#include "Options.h"
+
+namespace {
+
+// Import and/or export the high score table, without starting the game
+bool runScoreTool(const GameOptions& options) {
+    HighScoreManager scores;
+    bool ok = scores.load();
+    if (ok && !options.importScoresPath.empty()) {
+        ok = scores.importJson(options.importScoresPath);
+    }
+    if (ok && !options.exportScoresPath.empty()) {
+        ok = scores.exportJson(options.exportScoresPath);
+    }
+    return scores.flush() && ok;
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
-    // Suppress unused parameter warnings
-    (void)argc;
-    (void)argv;
+    GameOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    if (!options.importScoresPath.empty() || !options.exportScoresPath.empty()) {
+        return runScoreTool(options) ? 0 : 1;
+    }
 
     printf("=================================\n");
     printf("       SNAKE GAME v1.0\n");
@@ -24,7 +48,7 @@ int main(int argc, char* argv[]) {
     {
         std::unique_ptr<Game> game = std::make_unique<Game>();
 
-        if (!game->init()) {
+        if (!game->init(options)) {
             printf("Error: Failed to initialize game\n");
             SDL_Quit();
             return 1;
@@ -0,0 +1,143 @@
+// Packs the game's asset files into one file (see src/AssetPackFormat.h)
+//
+//   snake_packassets OUTPUT ROOT PATH...
+//
+// Every PATH is relative to ROOT; folders are packed with everything in
+// them except README files. Each file is stored under its path relative to
+// ROOT, which is the path the game opens it by. Missing paths are skipped,
+// since all assets are optional.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "AssetPackFormat.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PackFile {
+    std::string name;
+    std::vector<unsigned char> contents;
+};
+
+// Notes and instructions live next to the assets but aren't assets
+bool isPacked(const fs::path& file) {
+    return file.filename().string().rfind("README", 0) != 0;
+}
+
+bool addFile(const fs::path& root, const fs::path& file, std::vector<PackFile>& files) {
+    PackFile entry;
+    entry.name = file.lexically_relative(root).generic_string();
+    if (entry.name.size() >= AssetPackFormat::NAME_SIZE) {
+        printf("Error: Asset path too long for the pack: %s\n", entry.name.c_str());
+        return false;
+    }
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) {
+        printf("Error: Could not read %s\n", file.string().c_str());
+        return false;
+    }
+    entry.contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    files.push_back(std::move(entry));
+    return true;
+}
+
+bool collect(const fs::path& root, const std::string& path, std::vector<PackFile>& files) {
+    fs::path full = root / path;
+    std::error_code error;
+
+    if (fs::is_regular_file(full, error)) {
+        return addFile(root, full, files);
+    }
+    if (!fs::is_directory(full, error)) {
+        printf("Note: %s not found, not packed\n", path.c_str());
+        return true;
+    }
+
+    for (const auto& item : fs::recursive_directory_iterator(full, error)) {
+        if (item.is_regular_file() && isPacked(item.path())) {
+            if (!addFile(root, item.path(), files)) return false;
+        }
+    }
+    return !error;
+}
+
+size_t alignUp(size_t offset) {
+    const size_t align = AssetPackFormat::ALIGNMENT;
+    return (offset + align - 1) / align * align;
+}
+
+bool writePack(const char* output, std::vector<PackFile>& files) {
+    using namespace AssetPackFormat;
+
+    std::sort(files.begin(), files.end(),
+              [](const PackFile& a, const PackFile& b) { return a.name < b.name; });
+
+    // Header and index, then each blob at the next aligned offset
+    std::vector<unsigned char> head(HEADER_SIZE + files.size() * ENTRY_SIZE, 0);
+    std::copy(MAGIC, MAGIC + sizeof(MAGIC), head.begin());
+    writeU32(&head[8], VERSION);
+    writeU32(&head[12], static_cast<uint32_t>(files.size()));
+
+    std::vector<size_t> offsets;
+    size_t offset = alignUp(head.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        unsigned char* record = &head[HEADER_SIZE + i * ENTRY_SIZE];
+        std::copy(files[i].name.begin(), files[i].name.end(), record);
+        writeU64(record + NAME_SIZE, offset);
+        writeU64(record + NAME_SIZE + 8, files[i].contents.size());
+
+        offsets.push_back(offset);
+        offset = alignUp(offset + files[i].contents.size());
+    }
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        printf("Error: Could not create %s\n", output);
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(head.data()), head.size());
+    size_t written = head.size();
+    const char padding[ALIGNMENT] = {};
+    for (size_t i = 0; i < files.size(); ++i) {
+        out.write(padding, offsets[i] - written);
+        out.write(reinterpret_cast<const char*>(files[i].contents.data()),
+                  files[i].contents.size());
+        written = offsets[i] + files[i].contents.size();
+    }
+
+    if (!out) {
+        printf("Error: Could not write %s\n", output);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: snake_packassets OUTPUT ROOT PATH...\n");
+        return 1;
+    }
+
+    const fs::path root = argv[2];
+    std::vector<PackFile> files;
+    for (int i = 3; i < argc; ++i) {
+        if (!collect(root, argv[i], files)) return 1;
+    }
+
+    if (!writePack(argv[1], files)) return 1;
+
+    size_t total = 0;
+    for (const PackFile& file : files) total += file.contents.size();
+    printf("Packed %zu files (%zu bytes) into %s\n", files.size(), total, argv[1]);
+    return 0;
+}